@@ -38,7 +38,7 @@ Usage:
   sr -v | --version
 
 Arguments:
-  DATASET  filepath of the training set
+  DATASET  filepath of the training set (CSV, XRFF or binary `.vdf` format)
 
 Options:
   -h --help              shows this screen and exit
@@ -47,6 +47,8 @@ Options:
   --verbose              turns on information messages
   --debug                prints debug information
   --symbols=SYMBOLS      file specifying symbols used to solve the task
+  --convert=FILE         saves the dataset in the binary format (a `.vdf`
+                         file which is loaded much faster) and exits
   --validation=<perc>    sets the percent of the dataset used for validation
   --evaluator=<eval>     sets the preferred evaluator
                          (count, mae, rmae, mse, binary, dynslot, gaussian)
@@ -66,9 +68,13 @@ Options:
   --max-stuck-time=<st>  sets the maximum number of generations without
                          improvement in a run
   --runs=<runs>          number of runs to be tried
+  --concurrent-runs=<n>  number of runs performed at the same time
   --mate-zone=<dist>     mating zone (0 for panmictic)
   --threshold=<val>      success threshold for a run
   --cache=<bits>         cache will contain `2^bits` elements
+  --semantic-cache=<n>   enables the semantic cache (program outputs on `n`
+                         examples identify behaviourally equivalent programs)
+  --threads=<n>          number of concurrent workers used by the evolution
   --random-seed=<seed>   sets the seed for the pseudo-random number generator
                          (equences are repeatable by using the same seed value)
   --stat-dir=DIR         base path for log files
@@ -169,6 +175,10 @@ std::string eva_args;
 // Active validation strategy.
 vita::validator_id validator(vita::validator_id::undefined);
 
+// Output file for the binary version of the dataset (empty for no
+// conversion).
+std::string convert_to;
+
 // Reference problem (the problem we will work on).
 vita::src_problem *problem;
 
@@ -233,6 +243,13 @@ void crossover_rate(const args_t &a)
   vitaINFO << "Crossover rate set to " << problem->env.p_cross;
 }
 
+// Requires the conversion of the dataset to the binary format.
+void convert(const args_t &a)
+{
+  if (const auto value = a.at("--convert"))
+    convert_to = value.asString();
+}
+
 // Loads the training set.
 void data(const args_t &a)
 {
@@ -437,6 +454,42 @@ void tournament_size(const args_t &a)
   vitaINFO << "Tournament size set to " << problem->env.tournament_size;
 }
 
+// Sets the number of concurrent workers used by the evolution loop.
+void threads(const args_t &a)
+{
+  const auto value(a.at("--threads"));
+  if (!value)
+    return;
+
+  const auto n(value.asLong());
+  if (n <= 0)
+  {
+    vitaWARNING << "Wrong number of threads. Using default value";
+    return;
+  }
+
+  problem->env.threads = n;
+  vitaINFO << "Threads set to " << problem->env.threads;
+}
+
+// Sets the number of runs performed at the same time.
+void concurrent_runs(const args_t &a)
+{
+  const auto value(a.at("--concurrent-runs"));
+  if (!value)
+    return;
+
+  const auto n(value.asLong());
+  if (n <= 0)
+  {
+    vitaWARNING << "Wrong number of concurrent runs. Using default value";
+    return;
+  }
+
+  problem->env.concurrent_runs = n;
+  vitaINFO << "Concurrent runs set to " << problem->env.concurrent_runs;
+}
+
 // Sets the number of layers of the population.
 void layers(const args_t &a)
 {
@@ -642,6 +695,24 @@ void cache(const args_t &a)
   vitaINFO << "Cache size is " << bits << " bits";
 }
 
+// Enables the semantic cache.
+void semantic_cache(const args_t &a)
+{
+  const auto value(a.at("--semantic-cache"));
+  if (!value)
+    return;
+
+  const auto n(value.asLong());
+  if (n <= 0)
+  {
+    vitaWARNING << "Wrong number of probe examples. Semantic cache disabled";
+    return;
+  }
+
+  problem->env.semantic_cache.probes = n;
+  vitaINFO << "Semantic cache probes " << n << " examples";
+}
+
 // Sets percent of the dataset used for validation.
 //
 // Range is `[0,1]` or `[0%,100%]`.
@@ -692,6 +763,7 @@ void parse_command_line(int argc, char *const argv[])
   ui::verbosity(args);
 
   ui::cache(args);
+  ui::semantic_cache(args);
   ui::evaluator(args);
   ui::random_seed(args);
 
@@ -702,11 +774,13 @@ void parse_command_line(int argc, char *const argv[])
   ui::mutation_rate(args);
   ui::crossover_rate(args);
   ui::tournament_size(args);
+  ui::threads(args);
   ui::brood(args);
   ui::dss(args);
   ui::generations(args);
   ui::max_stuck_time(args);
   ui::set_runs(args);
+  ui::concurrent_runs(args);
   ui::mate_zone(args);
   ui::threshold(args);
 
@@ -717,6 +791,7 @@ void parse_command_line(int argc, char *const argv[])
   ui::stat_summary(args);
 
   ui::data(args);
+  ui::convert(args);
   ui::symbols(args);
   ui::validation(args);
 }
@@ -733,6 +808,13 @@ int main(int argc, char *const argv[])
   if (!problem.data().size())
     return EXIT_FAILURE;
 
+  if (!ui::convert_to.empty())
+  {
+    problem.data().write_binary(ui::convert_to);
+    vitaOUTPUT << "Dataset saved in " << ui::convert_to;
+    return EXIT_SUCCESS;
+  }
+
   ui::go();
 
   return EXIT_SUCCESS;
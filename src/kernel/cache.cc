@@ -10,6 +10,7 @@
  *  You can obtain one at http://mozilla.org/MPL/2.0/
  */
 
+#include <algorithm>
 #include <mutex>
 
 #include "kernel/cache.h"
@@ -21,8 +22,14 @@ namespace vita
 ///
 /// \param[in] bits `2^bits` is the number of elements of the table
 ///
-cache::cache(unsigned bits) : mutex_(), k_mask((1ull << bits) - 1),
-                              table_(1ull << bits), seal_(1)
+/// \remark
+/// The number of elements is rounded up to a multiple of `k_ways`.
+///
+cache::cache(unsigned bits)
+  : mutex_(),
+    k_mask(std::max<std::uint64_t>((1ull << bits) / k_ways, 1) - 1),
+    table_(k_mask + 1), seal_(1), tick_(0), hits_(0), misses_(0),
+    evictions_(0), collisions_(0)
 {
   Expects(bits);
   Ensures(is_valid());
@@ -30,29 +37,43 @@ cache::cache(unsigned bits) : mutex_(), k_mask((1ull << bits) - 1),
 
 ///
 /// \param[in] h the signature of an individual
-/// \return      an index in the hash table
+/// \return      the bucket where `h` can be stored
+///
+inline cache::bucket &cache::bucket_of(const hash_t &h)
+{
+  return table_[h.data[0] & k_mask];
+}
+
+///
+/// \param[in] h the signature of an individual
+/// \return      the bucket where `h` can be stored
+///
+inline const cache::bucket &cache::bucket_of(const hash_t &h) const
+{
+  return table_[h.data[0] & k_mask];
+}
+
+///
+/// \param[in] s a slot of the table
+/// \return      `true` if `s` contains an entry of the current generation
 ///
-inline std::size_t cache::index(const hash_t &h) const
+inline bool cache::valid(const slot &s) const
 {
-  return h.data[0] & k_mask;
+  return s.seal == seal_ && !s.hash.empty();
 }
 
 ///
-/// Clears the content and the statistical informations of the table.
+/// Clears the content of the table.
 ///
-/// \note Allocated size isn't changed.
+/// \note
+/// Allocated size isn't changed. Statistics are kept (they refer to the whole
+/// life of the table).
 ///
 void cache::clear()
 {
   std::unique_lock lock(mutex_);
 
   ++seal_;
-
-  // for (auto &s : table_)
-  // {
-  //   s.hash = hash_t();
-  //   s.fitness = {};
-  // }
 }
 
 ///
@@ -64,11 +85,9 @@ void cache::clear(const hash_t &h)
 {
   std::unique_lock lock(mutex_);
 
-  table_[index(h)].hash = hash_t();
-
-  // An alternative to invalidate the slot:
-  //   table_[index(h)].seal = 0;
-  // It works because the first valid seal is 1.
+  for (auto &s : bucket_of(h).slots)
+    if (s.hash == h)
+      s.hash = hash_t();
 }
 
 ///
@@ -78,18 +97,23 @@ void cache::clear(const hash_t &h)
 /// \return      the fitness of the individual. If the individuals isn't
 ///              present returns an empty fitness
 ///
-const fitness_t &cache::find(const hash_t &h) const
+/// \remark
+/// The fitness is returned by value: a reference would be exposed to
+/// concurrent insertions once the lock is released.
+///
+fitness_t cache::find(const hash_t &h) const
 {
   std::shared_lock lock(mutex_);
 
-  const slot &s(table_[index(h)]);
-  const bool ret(seal_ == s.seal && h == s.hash);
-
-  if (ret)
-    return s.fitness;
+  for (const auto &s : bucket_of(h).slots)
+    if (s.seal == seal_ && s.hash == h)
+    {
+      hits_.fetch_add(1, std::memory_order_relaxed);
+      return s.fitness;
+    }
 
-  static const fitness_t empty{};
-  return empty;
+  misses_.fetch_add(1, std::memory_order_relaxed);
+  return {};
 }
 
 ///
@@ -103,12 +127,93 @@ void cache::insert(const hash_t &h, const fitness_t &fitness)
 {
   std::unique_lock lock(mutex_);
 
-  slot s;
-  s.hash    =       h;
-  s.fitness = fitness;
-  s.seal    =   seal_;
+  store(h, fitness);
+}
+
+///
+/// Places an entry in its bucket.
+///
+/// \param[in] h       signature of an individual
+/// \param[in] fitness the fitness of the individual
+///
+/// The entry goes, in order of preference, into:
+/// - the slot already containing `h`;
+/// - a free (or expired) slot;
+/// - the slot containing the oldest entry.
+///
+/// \warning The caller must hold an exclusive lock.
+///
+void cache::store(const hash_t &h, const fitness_t &fitness)
+{
+  auto &b(bucket_of(h));
+
+  slot *target(nullptr);
+  slot *free(nullptr);
+  slot *oldest(nullptr);
+  bool others(false);
+
+  for (auto &s : b.slots)
+    if (!valid(s))
+    {
+      if (!free)
+        free = &s;
+    }
+    else if (s.hash == h)
+    {
+      target = &s;
+      break;
+    }
+    else
+    {
+      others = true;
+      if (!oldest || s.birth < oldest->birth)
+        oldest = &s;
+    }
+
+  if (!target)
+  {
+    if (others)
+      collisions_.fetch_add(1, std::memory_order_relaxed);
+
+    if (free)
+      target = free;
+    else
+    {
+      target = oldest;
+      evictions_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  target->hash    =       h;
+  target->fitness = fitness;
+  target->seal    =   seal_;
+  target->birth   = tick_++;
+}
+
+///
+/// \return the usage counters of the table
+///
+cache::statistics cache::stats() const
+{
+  statistics ret;
+
+  ret.hits       = hits_.load(std::memory_order_relaxed);
+  ret.misses     = misses_.load(std::memory_order_relaxed);
+  ret.evictions  = evictions_.load(std::memory_order_relaxed);
+  ret.collisions = collisions_.load(std::memory_order_relaxed);
+
+  return ret;
+}
+
+///
+/// \return the fraction of successful lookups (`0` if there aren't lookups)
+///
+double cache::statistics::hit_rate() const
+{
+  const auto lookups(hits + misses);
 
-  table_[index(s.hash)] = s;
+  return lookups ? static_cast<double>(hits) / static_cast<double>(lookups)
+                 : 0.0;
 }
 
 ///
@@ -130,21 +235,21 @@ bool cache::load(std::istream &in)
   if (!(in >> n))
     return false;
 
+  seal_ = t_seal;
+
   for (decltype(n) i(0); i < n; ++i)
   {
-    slot s;
-    s.seal = t_seal;
-
-    if (!s.hash.load(in))
+    hash_t h;
+    if (!h.load(in))
       return false;
-    if (!s.fitness.load(in))
+
+    fitness_t f;
+    if (!f.load(in))
       return false;
 
-    table_[index(s.hash)] = s;
+    store(h, f);
   }
 
-  seal_ = t_seal;
-
   return true;
 }
 
@@ -159,17 +264,19 @@ bool cache::save(std::ostream &out) const
   out << seal_ << ' ' << '\n';
 
   std::size_t num(0);
-  for (const auto &s : table_)
-    if (!s.hash.empty())
-      ++num;
+  for (const auto &b : table_)
+    for (const auto &s : b.slots)
+      if (valid(s))
+        ++num;
   out << num << '\n';
 
-  for (const auto &s : table_)
-    if (s.seal == seal_ && !s.hash.empty())
-    {
-      s.hash.save(out);
-      s.fitness.save(out);
-    }
+  for (const auto &b : table_)
+    for (const auto &s : b.slots)
+      if (valid(s))
+      {
+        s.hash.save(out);
+        s.fitness.save(out);
+      }
 
   return out.good();
 }
@@ -179,6 +286,16 @@ bool cache::save(std::ostream &out) const
 ///
 bool cache::is_valid() const
 {
+  for (const auto &b : table_)
+    for (auto i(b.slots.begin()); i != b.slots.end(); ++i)
+      if (valid(*i))
+        for (auto j(std::next(i)); j != b.slots.end(); ++j)
+          if (valid(*j) && i->hash == j->hash)
+          {
+            vitaERROR << "Duplicated entry in a bucket";
+            return false;
+          }
+
   return true;
 }
 
@@ -13,6 +13,8 @@
 #if !defined(VITA_CACHE_H)
 #define      VITA_CACHE_H
 
+#include <array>
+#include <atomic>
 #include <shared_mutex>
 
 #include "kernel/cache_hash.h"
@@ -28,11 +30,39 @@ namespace vita
 /// individuals are often generated and cache can give a significant speed
 /// improvement avoiding the recalculation of shared information.
 ///
+/// The table is set-associative: a signature maps to a bucket of `k_ways`
+/// slots and can be stored in any of them. When the bucket is full the oldest
+/// entry is replaced.
+///
+/// A slot (signature, fitness, seal and insertion time) takes roughly a cache
+/// line, so a bucket spans `k_ways` adjacent lines. Buckets are aligned to a
+/// cache line boundary: a lookup touches only its own bucket, but it can read
+/// more than one line.
+///
 class cache
 {
 public:
   DISALLOW_COPY_AND_ASSIGN(cache);
 
+  /// Number of slots of a bucket.
+  static constexpr std::size_t k_ways = 4;
+
+  /// Usage counters of the table.
+  struct statistics
+  {
+    /// Successful lookups.
+    std::uint64_t hits = 0;
+    /// Failed lookups.
+    std::uint64_t misses = 0;
+    /// Valid entries replaced by the insertion of a different individual.
+    std::uint64_t evictions = 0;
+    /// Insertions in a bucket already containing valid entries of other
+    /// individuals.
+    std::uint64_t collisions = 0;
+
+    double hit_rate() const;
+  };
+
   explicit cache(unsigned);
 
   void clear();
@@ -40,7 +70,9 @@ public:
 
   void insert(const hash_t &, const fitness_t &);
 
-  const fitness_t &find(const hash_t &) const;
+  fitness_t find(const hash_t &) const;
+
+  statistics stats() const;
 
   bool is_valid() const;
 
@@ -49,9 +81,6 @@ public:
   bool save(std::ostream &) const;
 
 private:
-  // Private support methods.
-  std::size_t index(const hash_t &) const;
-
   // Private data members.
   struct slot
   {
@@ -61,13 +90,31 @@ private:
     fitness_t fitness;
     /// Valid slots are recognized comparing their seal with the current one.
     unsigned     seal;
+    /// Insertion time (used by the replacement policy).
+    std::uint64_t birth;
+  };
+
+  struct alignas(64) bucket
+  {
+    std::array<slot, k_ways> slots;
   };
 
+  // Private support methods.
+  bucket &bucket_of(const hash_t &);
+  const bucket &bucket_of(const hash_t &) const;
+  bool valid(const slot &) const;
+  void store(const hash_t &, const fitness_t &);
+
   mutable std::shared_mutex mutex_;
 
-  const std::uint64_t k_mask;
-  std::vector<slot>   table_;
+  const std::uint64_t  k_mask;
+  std::vector<bucket>  table_;
   decltype(slot::seal) seal_;
+  std::uint64_t        tick_;
+
+  // Lookups happen under a shared lock: counters must be atomic.
+  mutable std::atomic<std::uint64_t> hits_, misses_;
+  std::atomic<std::uint64_t> evictions_, collisions_;
 };
 
 /// \example example4.cc
@@ -40,6 +40,9 @@ public:
   fitness_t operator()(const T &) override;
   fitness_t fast(const T &) override;
 
+  void read_only(bool) override;
+  [[nodiscard]] bool read_only() const override;
+
   std::unique_ptr<basic_lambda_f> lambdify(const T &) const override;
 
 private:
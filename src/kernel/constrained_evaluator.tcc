@@ -50,6 +50,24 @@ fitness_t constrained_evaluator<T, E, P>::fast(const T &prg)
                  eva_.fast(prg));
 }
 
+///
+/// \param[in] v `true` if the base evaluator mustn't change the training data
+///
+template<class T, class E, class P>
+void constrained_evaluator<T, E, P>::read_only(bool v)
+{
+  eva_.read_only(v);
+}
+
+///
+/// \return `true` if the base evaluator doesn't change the training data
+///
+template<class T, class E, class P>
+bool constrained_evaluator<T, E, P>::read_only() const
+{
+  return eva_.read_only();
+}
+
 ///
 /// \param[in] prg a program (individual/team)
 /// \return        a pointer to the executable version of `prg`
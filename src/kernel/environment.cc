@@ -92,12 +92,25 @@ void environment::xml(tinyxml2::XMLDocument *d) const
   if (validation_percentage.has_value())
     set_text(e_environment, "validation_percentage", *validation_percentage);
   set_text(e_environment, "cache_bits", cache_size);  // size `1u<<cache_size`
+  set_text(e_environment, "threads", threads);
+  set_text(e_environment, "concurrent_runs", concurrent_runs);
 
   auto *e_alps(d->NewElement("alps"));
   e_environment->InsertEndChild(e_alps);
   set_text(e_alps, "age_gap", alps.age_gap);
   set_text(e_alps, "p_same_layer", alps.p_same_layer);
 
+  auto *e_island(d->NewElement("island"));
+  e_environment->InsertEndChild(e_island);
+  set_text(e_island, "migration_interval", island.migration_interval);
+  set_text(e_island, "migrants", island.migrants);
+  set_text(e_island, "topology", as_integer(island.topology));
+
+  auto *e_semantic(d->NewElement("semantic_cache"));
+  e_environment->InsertEndChild(e_semantic);
+  set_text(e_semantic, "probes", semantic_cache.probes);
+  set_text(e_semantic, "verification", semantic_cache.verification);
+
   auto *e_team(d->NewElement("team"));
   e_environment->InsertEndChild(e_team);
   set_text(e_team, "individuals", team.individuals);
@@ -262,6 +275,24 @@ bool environment::is_valid(bool force_defined) const
     return false;
   }
 
+  if (!threads)
+  {
+    vitaERROR << "`threads` out of range";
+    return false;
+  }
+
+  if (!concurrent_runs)
+  {
+    vitaERROR << "`concurrent_runs` out of range";
+    return false;
+  }
+
+  if (semantic_cache.verification < 0.0 || semantic_cache.verification > 1.0)
+  {
+    vitaERROR << "`semantic_cache.verification` out of range";
+    return false;
+  }
+
   if (alps.p_same_layer > 1.0)
   {
     vitaERROR << "`p_same_layer` out of range";
@@ -288,6 +319,14 @@ bool environment::is_valid(bool force_defined) const
     return false;
   }
 
+  if (individuals && island.migrants >= individuals)
+  {
+    vitaERROR << "`island.migrants` (" << island.migrants
+              << ") must be smaller than population size (" << individuals
+              << ")";
+    return false;
+  }
+
   if (mate_zone && tournament_size && tournament_size > mate_zone)
   {
     vitaERROR << "`tournament_size` (" << tournament_size
@@ -20,6 +20,7 @@
 #include "tinyxml2/tinyxml2.h"
 
 #include "kernel/alps.h"
+#include "kernel/island.h"
 #include "kernel/model_measurements.h"
 #include "kernel/log.h"
 #include "kernel/range.h"
@@ -92,7 +93,8 @@ public:
   /// When the evolution strategy is vita::basic_std_es, setting `layers > 1`
   /// is like running `n` evolutions "in parallel" (the sub-populations of each
   /// layer don't interact). A value greater than one is usually choosen for
-  /// vita::basic_alps_es or with other strategies that allow migrants.
+  /// vita::basic_alps_es or with other strategies that allow migrants (e.g.
+  /// vita::island_es, where every layer is an island).
   ///
   /// \note A value of 0 means undefined (auto-tune).
   unsigned layers = 0;
@@ -219,6 +221,57 @@ public:
   /// `2^cache_size` is the number of elements of the cache.
   unsigned cache_size = 16;
 
+  struct semantic_cache_parameters
+  {
+    /// Number of examples used to compute the semantic fingerprint of a
+    /// program (see `evaluator::fingerprint`). Programs with the same
+    /// fingerprint share the fitness stored in the semantic cache of
+    /// `evaluator_proxy`.
+    ///
+    /// \note `0` disables the semantic cache.
+    unsigned probes = 0;
+
+    /// Fraction of the semantic cache hits verified via a full evaluation
+    /// (the verified fitness replaces the stored one). Hits to be verified
+    /// are chosen via the signature of the program: the random engine isn't
+    /// used.
+    double verification = 0.1;
+  } semantic_cache;
+
+  /// Number of concurrent workers used by the evolution loop.
+  ///
+  /// Workers select and recombine individuals of the shared population (the
+  /// replacement phase is sequential). Given the random seed and the number of
+  /// threads, the evolution is reproducible (see `evolution::concurrent`).
+  /// `1` gives the classic, steady state, evolution.
+  ///
+  /// \note
+  /// - Only some evolution strategies support concurrent workers (others
+  ///   silently fall back to `1`).
+  /// - Validation strategies altering the training data during the evolution
+  ///   (e.g. DSS) fall back to `1`.
+  /// - The evaluator must be safe to call from multiple threads. During the
+  ///   evolution it's switched to read-only mode (see
+  ///   `evaluator::read_only`).
+  unsigned threads = 1;
+
+  /// Number of search runs performed at the same time.
+  ///
+  /// `1` performs the runs one after another (sharing the random engine of
+  /// the calling thread). With larger values every run has its own population
+  /// and random stream (see `random::streams`), so, given the random seed,
+  /// the result of a run doesn't depend on the scheduling of the runs (but
+  /// differs from the result obtained with `concurrent_runs == 1`).
+  ///
+  /// \note
+  /// - Only validation strategies that don't alter the training data during
+  ///   the evolution support concurrent runs (others silently fall back to
+  ///   `1`).
+  /// - Runs share the evaluators (and the training data), that must be safe
+  ///   to call from multiple threads. The training evaluator is used in
+  ///   read-only mode (see `evaluator::read_only`).
+  unsigned concurrent_runs = 1;
+
   struct misc_parameters
   {
     /// Filename used for persistance. An empty name is used to skip
@@ -267,6 +320,8 @@ public:
 
   alps::parameters alps;
 
+  island::parameters island;
+
   struct de_parameters
   {
     /// Weighting factor range (aka differential factor range).
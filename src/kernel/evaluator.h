@@ -13,6 +13,9 @@
 #if !defined(VITA_EVALUATOR_H)
 #define      VITA_EVALUATOR_H
 
+#include <optional>
+
+#include "kernel/cache.h"
 #include "kernel/fitness.h"
 #include "kernel/gp/src/lambda_f.h"
 #include "kernel/random.h"
@@ -26,6 +29,23 @@ public:
   /// Clear possible cached values.
   /// \note The default implementation is empty.
   virtual void clear() {}
+
+  /// \return usage statistics of the cache (if available)
+  /// \note The default implementation has no cache.
+  virtual std::optional<cache::statistics> cache_stats() const { return {}; }
+};
+
+///
+/// Result of an evaluation that can be interrupted (see `evaluator::race`).
+///
+struct race_result
+{
+  /// The fitness or, for an interrupted evaluation, an upper bound of the
+  /// fitness (not greater than the bound given to `evaluator::race`).
+  fitness_t fitness;
+
+  /// `false` for an interrupted evaluation.
+  bool exact;
 };
 
 ///
@@ -64,6 +84,10 @@ public:
 
   // The following methods have a default implementation (usually empty).
   virtual fitness_t fast(const T &);
+  virtual race_result race(const T &, const fitness_t &);
+  virtual hash_t fingerprint(const T &, unsigned);
+  virtual void read_only(bool);
+  [[nodiscard]] virtual bool read_only() const;
   virtual std::unique_ptr<basic_lambda_f> lambdify(const T &) const;
 };
 
@@ -34,6 +34,76 @@ fitness_t evaluator<T>::fast(const T &i)
   return operator()(i);
 }
 
+///
+/// Evaluates an individual that is useful only if its fitness is greater than
+/// a given bound.
+///
+/// \param[in] i     an individual to be evaluated
+/// \param[in] bound the fitness to be beaten
+/// \return          the fitness of `i` or, if `i` cannot beat `bound`, possibly
+///                  an upper bound of the fitness (marked as not exact)
+///
+/// Evaluators can stop as soon as the partial result proves that the fitness
+/// of `i` isn't greater than `bound` (racing). An interrupted evaluation
+/// saves time but its result must not be used as the fitness of `i`.
+///
+/// \note Default implementation calls the standard fitness function.
+///
+template<class T>
+race_result evaluator<T>::race(const T &i, const fitness_t &)
+{
+  return {operator()(i), true};
+}
+
+///
+/// Summarises the behaviour of an individual.
+///
+/// \param[in] i      an individual
+/// \param[in] probes number of test cases considered
+/// \return           a hash of the outputs of `i` on `probes` (fixed) test
+///                   cases or an empty hash if the evaluator doesn't support
+///                   fingerprints
+///
+/// Individuals with distinct signatures can behave in the same way (e.g.
+/// `X+X` and `2*X`). When the fitness only depends on the outputs of an
+/// individual, the same fingerprint is a strong clue of the same fitness (see
+/// the semantic cache of `evaluator_proxy`).
+///
+/// \note Default implementation doesn't support fingerprints.
+///
+template<class T>
+hash_t evaluator<T>::fingerprint(const T &, unsigned)
+{
+  return hash_t();
+}
+
+///
+/// Enables / disables the read-only mode.
+///
+/// \param[in] v `true` if the evaluator mustn't change the training data
+///
+/// Some evaluators update the training data as a side effect (e.g. the
+/// difficulty of the examples, used by DSS). In read-only mode they don't and
+/// can be called by many threads at the same time.
+///
+/// \note Default implementation is empty (no side effects).
+///
+template<class T>
+void evaluator<T>::read_only(bool)
+{
+}
+
+///
+/// \return `true` if the evaluator doesn't change the training data
+///
+/// \note Default implementation returns `true` (no side effects).
+///
+template<class T>
+bool evaluator<T>::read_only() const
+{
+  return true;
+}
+
 ///
 /// \param[in] in input stream
 /// \return       `true` if the object loaded correctly
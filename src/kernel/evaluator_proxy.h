@@ -15,6 +15,7 @@
 
 #include "kernel/cache.h"
 #include "kernel/evaluator.h"
+#include "kernel/lockfree_cache.h"
 
 namespace vita
 {
@@ -22,33 +23,63 @@ namespace vita
 /// Provides a surrogate for an evaluator to control access to it.
 ///
 /// \tparam T the type of individual used
+/// \tparam E the real evaluator
+/// \tparam C the hash table (`cache` or, for many concurrent evaluating
+///           threads, `lockfree_cache`)
 ///
 /// evaluator_proxy uses an ad-hoc internal hash table to cache fitness scores
 /// of individuals.
 ///
-template<class T, class E>
+/// An optional second table (the *semantic cache*) links the fingerprint of
+/// an individual (see `evaluator::fingerprint`) to its fitness. Programs with
+/// distinct signatures but the same behaviour on the probe examples (e.g.
+/// `X+X` and `2*X`, dead branches of conditional functions...) reuse the
+/// fitness of the first one evaluated. A fraction of the semantic hits is
+/// verified via a full evaluation (see `environment::semantic_cache`).
+///
+/// \warning
+/// Fitness values taken from the semantic cache can be wrong (programs that
+/// agree on the probe examples and disagree elsewhere). They're stored in the
+/// signature-based table as well (the verification isn't repeated for the
+/// same program). The semantic cache is only suitable for fitness functions
+/// depending just on the outputs of an individual.
+///
+template<class T, class E, class C = cache>
 class evaluator_proxy : public evaluator<T>
 {
 public:
-  evaluator_proxy(E, unsigned);
+  evaluator_proxy(E, unsigned,
+                  const environment::semantic_cache_parameters & = {});
 
   // Serialization.
   bool load(std::istream &) override;
   bool save(std::ostream &) const override;
 
   void clear() override;
+  std::optional<cache::statistics> cache_stats() const override;
+  [[nodiscard]] std::optional<cache::statistics> semantic_stats() const;
 
   fitness_t operator()(const T &) override;
   fitness_t fast(const T &) override;
+  race_result race(const T &, const fitness_t &) override;
+
+  void read_only(bool) override;
+  [[nodiscard]] bool read_only() const override;
 
   std::unique_ptr<basic_lambda_f> lambdify(const T &) const override;
 
 private:
+  fitness_t semantic_find(const T &, hash_t &);
+
   // Access to the real evaluator.
   E eva_;
 
   // Hash table cache.
-  cache cache_;
+  C cache_;
+
+  // Semantic cache (fingerprint to fitness). Empty when disabled.
+  std::optional<C> semantic_;
+  environment::semantic_cache_parameters semantic_params_;
 };
 
 #include "kernel/evaluator_proxy.tcc"
@@ -19,29 +19,72 @@
 
 ///
 /// \param[in] eva pointer that lets the proxy access the real evaluator
-/// \param[in] ts  `2^ts` is the number of elements of the cache
+/// \param[in] ts  `2^ts` is the number of elements of the cache (and of the
+///                semantic cache)
+/// \param[in] sp  parameters of the semantic cache (disabled by default)
 ///
-template<class T, class E>
-evaluator_proxy<T, E>::evaluator_proxy(E eva, unsigned ts)
-  : eva_(std::move(eva)), cache_(ts)
+template<class T, class E, class C>
+evaluator_proxy<T, E, C>::evaluator_proxy(
+  E eva, unsigned ts, const environment::semantic_cache_parameters &sp)
+  : eva_(std::move(eva)), cache_(ts), semantic_(), semantic_params_(sp)
 {
   Expects(ts > 6);
+  Expects(0.0 <= sp.verification && sp.verification <= 1.0);
+
+  if (semantic_params_.probes)
+    semantic_.emplace(ts);
+}
+
+///
+/// Looks for the fitness of a program behaving like `prg`.
+///
+/// \param[in]  prg a program (individual/team)
+/// \param[out] fp  the fingerprint of `prg` (empty if the semantic cache is
+///                 disabled or the evaluator doesn't support fingerprints)
+/// \return         the fitness stored in the semantic cache (empty if there
+///                 isn't a match or if the match has to be verified)
+///
+template<class T, class E, class C>
+fitness_t evaluator_proxy<T, E, C>::semantic_find(const T &prg, hash_t &fp)
+{
+  fp.clear();
+
+  if (!semantic_)
+    return {};
+
+  fp = eva_.fingerprint(prg, semantic_params_.probes);
+  if (fp.empty())
+    return {};
+
+  fitness_t f(semantic_->find(fp));
+
+  // A fraction of the hits is verified. The choice depends on the signature
+  // of `prg`, not on the random engine: enabling the semantic cache doesn't
+  // change the random sequence used by the evolution.
+  const double u(static_cast<double>(prg.signature().data[1] >> 11)
+                 * 0x1.0p-53);
+  if (f.size() && u < semantic_params_.verification)
+    return {};
+
+  return f;
 }
 
 ///
 /// \param[in] prg the program (individual/team) whose fitness we want to know
 /// \return        the fitness of `prg`
 ///
-template<class T, class E>
-fitness_t evaluator_proxy<T, E>::operator()(const T &prg)
+template<class T, class E, class C>
+fitness_t evaluator_proxy<T, E, C>::operator()(const T &prg)
 {
   fitness_t f(cache_.find(prg.signature()));
 
   if (f.size())
   {
     // Hash collision checking code can slow down the program very much.
+    // Values coming from the semantic cache can be approximated, so they
+    // aren't checked.
 #if !defined(NDEBUG)
-    const fitness_t f1(eva_(prg));
+    const fitness_t f1(semantic_ ? f : eva_(prg));
     if (!almost_equal(f[0], f1[0]))
       std::cerr << "********* COLLISION ********* [" << f << " != " << f1
                 << "]\n";
@@ -64,14 +107,27 @@ fitness_t evaluator_proxy<T, E>::operator()(const T &prg)
   }
   else  // not found in cache
   {
-    f = eva_(prg);
+    hash_t fp;
+    f = semantic_find(prg, fp);
+
+    if (!f.size())  // not found in the semantic cache
+    {
+      f = eva_(prg);
+
+      if (!fp.empty())
+        semantic_->insert(fp, f);
+    }
 
+    // Semantic hits are stored too: further requests for `prg` don't roll
+    // the verification again.
     cache_.insert(prg.signature(), f);
 
 #if !defined(NDEBUG)
+    // `lockfree_cache` can drop an insertion (concurrent writers, fitness
+    // too big).
     fitness_t f1(cache_.find(prg.signature()));
-    assert(f1.size());
-    assert(almost_equal(f, f1));
+    assert(f1.size() || !std::is_same_v<C, cache>);
+    assert(!f1.size() || almost_equal(f, f1));
 #endif
   }
 
@@ -85,12 +141,65 @@ fitness_t evaluator_proxy<T, E>::operator()(const T &prg)
 /// \remark
 /// The approximated ("fast") fitness isn't stored in the cache.
 ///
-template<class T, class E>
-fitness_t evaluator_proxy<T, E>::fast(const T &prg)
+template<class T, class E, class C>
+fitness_t evaluator_proxy<T, E, C>::fast(const T &prg)
 {
   return eva_.fast(prg);
 }
 
+///
+/// \param[in] prg   the program (individual/team) whose fitness we want to know
+/// \param[in] bound the fitness `prg` has to beat
+/// \return          the fitness of `prg` or an upper bound of the fitness not
+///                  greater than `bound` (see `evaluator::race`)
+///
+/// \remark
+/// - Only exact fitness values are stored in the cache.
+/// - A semantic hit is an approximation: it's never returned as an exact
+///   fitness. If it shows that `prg` cannot beat `bound` the evaluation is
+///   considered interrupted, otherwise `prg` is evaluated.
+///
+template<class T, class E, class C>
+race_result evaluator_proxy<T, E, C>::race(const T &prg,
+                                           const fitness_t &bound)
+{
+  if (fitness_t f(cache_.find(prg.signature())); f.size())
+    return {f, true};
+
+  hash_t fp;
+  if (fitness_t f(semantic_find(prg, fp));
+      f.size() && bound.size() && f <= bound)
+    return {f, false};
+
+  const auto r(eva_.race(prg, bound));
+  if (r.exact)
+  {
+    cache_.insert(prg.signature(), r.fitness);
+    if (!fp.empty())
+      semantic_->insert(fp, r.fitness);
+  }
+
+  return r;
+}
+
+///
+/// \param[in] v `true` if the real evaluator mustn't change the training data
+///
+template<class T, class E, class C>
+void evaluator_proxy<T, E, C>::read_only(bool v)
+{
+  eva_.read_only(v);
+}
+
+///
+/// \return `true` if the real evaluator doesn't change the training data
+///
+template<class T, class E, class C>
+bool evaluator_proxy<T, E, C>::read_only() const
+{
+  return eva_.read_only();
+}
+
 ///
 /// \param[in] in input stream
 /// \return       `true` if the object loaded correctly
@@ -100,8 +209,8 @@ fitness_t evaluator_proxy<T, E>::fast(const T &prg)
 /// The temporary object needed to holds values from the stream conceivably is
 /// too big to justify the "no change" warranty.
 ///
-template<class T, class E>
-bool evaluator_proxy<T, E>::load(std::istream &in)
+template<class T, class E, class C>
+bool evaluator_proxy<T, E, C>::load(std::istream &in)
 {
   return eva_.load(in) && cache_.load(in);
 }
@@ -110,27 +219,53 @@ bool evaluator_proxy<T, E>::load(std::istream &in)
 /// \param[out] out output stream
 /// \return         `true` if the object was saved correctly
 ///
-template<class T, class E>
-bool evaluator_proxy<T, E>::save(std::ostream &out) const
+template<class T, class E, class C>
+bool evaluator_proxy<T, E, C>::save(std::ostream &out) const
 {
   return eva_.save(out) && cache_.save(out);
 }
 
 ///
-/// Resets the evaluation cache.
+/// Resets the evaluation cache, the semantic cache and the caches of the
+/// real evaluator.
 ///
-template<class T, class E>
-void evaluator_proxy<T, E>::clear()
+template<class T, class E, class C>
+void evaluator_proxy<T, E, C>::clear()
 {
+  eva_.clear();
   cache_.clear();
+
+  if (semantic_)
+    semantic_->clear();
+}
+
+///
+/// \return usage statistics of the evaluation cache
+///
+template<class T, class E, class C>
+std::optional<cache::statistics> evaluator_proxy<T, E, C>::cache_stats() const
+{
+  return cache_.stats();
+}
+
+///
+/// \return usage statistics of the semantic cache (if enabled)
+///
+template<class T, class E, class C>
+std::optional<cache::statistics> evaluator_proxy<T, E, C>::semantic_stats()
+  const
+{
+  if (semantic_)
+    return semantic_->stats();
+  return {};
 }
 
 ///
 /// \param[in] prg a program (individual/team)
 /// \return        a pointer to the executable version of `prg`
 ///
-template<class T, class E>
-std::unique_ptr<basic_lambda_f> evaluator_proxy<T, E>::lambdify(
+template<class T, class E, class C>
+std::unique_ptr<basic_lambda_f> evaluator_proxy<T, E, C>::lambdify(
   const T &prg) const
 {
   return eva_.lambdify(prg);
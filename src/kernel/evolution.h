@@ -14,7 +14,11 @@
 #define      VITA_EVOLUTION_H
 
 #include <algorithm>
+#include <atomic>
 #include <csignal>
+#include <future>
+#include <mutex>
+#include <tuple>
 
 #include "kernel/evaluator_proxy.h"
 #include "kernel/evolution_strategy.h"
@@ -45,6 +49,7 @@ public:
   evolution(const problem &, evaluator<T> &);
 
   evolution &after_generation(after_generation_callback_t);
+  evolution &concurrent(bool);
 
   const summary<T> &run(unsigned);
   template<class S> const summary<T> &run(unsigned, S);
@@ -57,6 +62,11 @@ private:
   void log_evolution(unsigned) const;
   void print_progress(unsigned, unsigned, bool, timer *) const;
   bool stop_condition(const summary<T> &) const;
+  bool concurrent_generation(unsigned, unsigned, timer *);
+  bool island_generation(unsigned, unsigned, timer *);
+  void wait_workers(std::vector<std::future<void>> &,
+                    const std::atomic<unsigned> &, std::atomic<bool> *,
+                    unsigned, timer *) const;
 
   // *** Data members ***
   population<T> pop_;
@@ -65,6 +75,11 @@ private:
   ES<T>          es_;
 
   after_generation_callback_t after_generation_callback_;
+
+  // `false` when the evaluator changes the training data (e.g. the
+  // difficulty of the examples used by DSS) and cannot be shared by many
+  // workers.
+  bool concurrent_;
 };
 
 #include "kernel/evolution.tcc"
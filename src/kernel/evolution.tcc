@@ -77,7 +77,8 @@ inline void set()
 ///
 template<class T, template<class> class ES>
 evolution<T, ES>::evolution(const problem &p, evaluator<T> &eva)
-  : pop_(p), eva_(eva), es_(pop_, eva_, &stats_), after_generation_callback_()
+  : pop_(p), eva_(eva), es_(pop_, eva_, &stats_), after_generation_callback_(),
+    concurrent_(true)
 {
   Ensures(is_valid());
 }
@@ -96,6 +97,24 @@ evolution<T, ES> &evolution<T, ES>::after_generation(
   return *this;
 }
 
+///
+/// Allows / forbids concurrent workers (see `environment::threads`).
+///
+/// \param[in] c `false` if the evaluator cannot be shared by many workers
+/// \return      a reference to `*this` object (fluent interface)
+///
+/// Concurrent workers switch the evaluator to read-only mode (see
+/// `evaluator::read_only`): the difficulty of the training examples isn't
+/// updated. Validation strategies depending on it (e.g. DSS) require a single
+/// worker.
+///
+template<class T, template<class> class ES>
+evolution<T, ES> &evolution<T, ES>::concurrent(bool c)
+{
+  concurrent_ = c;
+  return *this;
+}
+
 ///
 /// \param[in] s an up to date evolution summary
 /// \return      `true` when evolution should be interrupted
@@ -125,8 +144,9 @@ analyzer<T> evolution<T, ES>::get_stats() const
 {
   analyzer<T> az;
 
-  for (auto it(pop_.begin()), end(pop_.end()); it != end; ++it)
-    az.add(*it, eva_(*it), it.layer());
+  for (unsigned l(0); l < pop_.layers(); ++l)
+    for (unsigned i(0); i < pop_.individuals(l); ++i)
+      az.add(pop_[{l, i}], pop_.fitness({l, i}, eva_), l);
 
   return az;
 }
@@ -153,9 +173,16 @@ analyzer<T> evolution<T, ES>::get_stats() const
 /// CSV-like file. Note also that it's simple to extract and plot data with
 /// GNU Plot.
 ///
+/// \remark
+/// With concurrent runs (see `environment::concurrent_runs`) blocks of
+/// different runs can be interleaved (every line starts with the run number).
+///
 template<class T, template<class> class ES>
 void evolution<T, ES>::log_evolution(unsigned run_count) const
 {
+  static std::mutex log_mutex;
+  std::lock_guard lock(log_mutex);
+
   static unsigned last_run(0);
 
   const auto &env(pop_.get_problem().env);
@@ -261,6 +288,235 @@ void evolution<T, ES>::print_progress(unsigned k, unsigned run_count,
   }
 }
 
+///
+/// Waits for the workers of a generation, monitoring their progress.
+///
+/// \param[in]  workers       the running workers
+/// \param[in]  produced      number of offspring produced so far
+/// \param[out] stop          set to `true` if the user asks to stop the
+///                           evolution
+/// \param[in]  run_count     run number (used for printing and logging)
+/// \param[in]  from_last_msg time elapsed from the last message
+///
+template<class T, template<class> class ES>
+void evolution<T, ES>::wait_workers(std::vector<std::future<void>> &workers,
+                                    const std::atomic<unsigned> &produced,
+                                    std::atomic<bool> *stop,
+                                    unsigned run_count,
+                                    timer *from_last_msg) const
+{
+  for (auto &w : workers)
+  {
+    while (w.wait_for(std::chrono::milliseconds(100))
+           != std::future_status::ready)
+      if (from_last_msg->elapsed() > std::chrono::seconds(2))
+      {
+        print_progress(produced, run_count, false, from_last_msg);
+
+        if (term::user_stop())
+          *stop = true;
+      }
+
+    w.get();
+  }
+}
+
+///
+/// Runs a generation using many concurrent workers.
+///
+/// \param[in] threads       number of workers
+/// \param[in] run_count     run number (used for printing and logging)
+/// \param[in] from_last_msg time elapsed from the last message
+/// \return                  `true` if the user asked to stop the evolution
+///
+/// The generation is split in two phases:
+/// 1. every worker produces (selection, recombination and evaluation) its
+///    share of the `individuals()` offspring. Workers only read the
+///    population (as it was at the beginning of the generation), use their
+///    own random stream (see `random::streams`) and update a partial summary;
+/// 2. the calling thread performs the replacements, worker after worker, in
+///    the order offspring were produced, reusing the evaluations of the
+///    first phase (see `replacement::tournament::evaluate`).
+///
+/// Workers use the evaluator in read-only mode (see `evaluator::read_only`)
+/// so, given the seed and the number of threads, the evolution is
+/// reproducible.
+///
+/// \remark
+/// Offspring are evaluated (raced, with elitism) during the first phase,
+/// concurrently, against the bound given by the population and the summary
+/// at the beginning of the generation. The second phase evaluates again only
+/// the interrupted evaluations that don't prove the child a loser anymore.
+///
+template<class T, template<class> class ES>
+bool evolution<T, ES>::concurrent_generation(unsigned threads,
+                                             unsigned run_count,
+                                             timer *from_last_msg)
+{
+  Expects(threads > 1);
+
+  // Individuals compute their signature lazily: do it now so that, during
+  // the generation, shared individuals are only read.
+  for (const auto &prg : pop_)
+    static_cast<void>(prg.signature());
+
+  using parents_t = typename selection::strategy<T>::parents_t;
+  using offspring_t = typename recombination::strategy<T>::offspring_t;
+  using birth_t = std::tuple<parents_t, offspring_t, race_result>;
+
+  const auto n(pop_.individuals());
+  std::atomic<unsigned> produced(0);
+  std::atomic<bool> stop(false);
+
+  const auto engines(random::streams(threads));
+  std::vector<summary<T>> partial(threads);
+  std::vector<std::vector<birth_t>> births(threads);
+
+  const auto worker([&](unsigned w)
+  {
+    random::engine = engines[w];
+    ES<T> es(pop_, eva_, &partial[w]);
+
+    const auto last(n * (w + 1) / threads);
+    for (auto k(n * w / threads); k < last && !stop; ++k)
+    {
+      auto parents(es.selection.run());
+      auto off(es.recombination.run(parents));
+
+      // Evaluation happens here, concurrently, and its result is used by the
+      // replacement phase.
+      for (const auto &o : off)
+        static_cast<void>(o.signature());
+      auto fit(es.replacement.evaluate(parents, off, stats_));
+
+      births[w].emplace_back(std::move(parents), std::move(off),
+                             std::move(fit));
+      ++produced;
+    }
+  });
+
+  std::vector<std::future<void>> workers;
+  for (unsigned w(0); w < threads; ++w)
+    workers.push_back(std::async(std::launch::async, worker, w));
+
+  wait_workers(workers, produced, &stop, run_count, from_last_msg);
+
+  const auto before(stats_.best.score.fitness);
+  for (unsigned w(0); w < threads; ++w)
+  {
+    stats_.crossovers += partial[w].crossovers;
+    stats_.mutations += partial[w].mutations;
+
+    for (auto &[parents, off, fit] : births[w])
+      es_.replacement.run(parents, std::move(off), fit, &stats_);
+  }
+
+  if (stats_.best.score.fitness != before)
+    print_progress(n, run_count, true, from_last_msg);
+
+  return stop;
+}
+
+///
+/// Runs a generation of an island model evolution strategy.
+///
+/// \param[in] threads       number of workers
+/// \param[in] run_count     run number (used for printing and logging)
+/// \param[in] from_last_msg time elapsed from the last message
+/// \return                  `true` if the user asked to stop the evolution
+///
+/// Every layer of the population is an island. Islands are statically
+/// assigned to workers (island `l` to worker `l % threads`) and every worker
+/// performs the select / recombine / replace cycle on its islands, using its
+/// own random stream (see `random::streams`). Islands don't interact during
+/// the generation (migration is performed by `ES::after_generation`), so
+/// workers don't need synchronisation and, given the seed and the number of
+/// threads, the evolution is reproducible.
+///
+/// With a single worker the islands are evolved on the calling thread.
+///
+template<class T, template<class> class ES>
+bool evolution<T, ES>::island_generation(unsigned threads,
+                                         unsigned run_count,
+                                         timer *from_last_msg)
+{
+  const auto islands(pop_.layers());
+  threads = std::clamp(threads, 1u, islands);
+
+  std::atomic<unsigned> produced(0);
+  std::atomic<bool> stop(false);
+
+  const auto engines(random::streams(threads));
+  std::vector<summary<T>> partial(threads);
+  for (auto &p : partial)
+  {
+    p.best = stats_.best;
+    p.gen = stats_.gen;
+    p.last_imp = stats_.last_imp;
+  }
+
+  const auto worker([&](unsigned w)
+  {
+    random::engine = engines[w];
+    ES<T> es(pop_, eva_, &partial[w]);
+
+    for (auto l(w); l < islands && !stop; l += threads)
+      for (unsigned k(0); k < pop_.individuals(l) && !stop; ++k)
+      {
+        // A single worker runs on the calling thread, which must also take
+        // care of the progress messages (see `wait_workers`).
+        if (threads == 1 && from_last_msg->elapsed() > std::chrono::seconds(2))
+        {
+          print_progress(produced, run_count, false, from_last_msg);
+
+          if (term::user_stop())
+            stop = true;
+        }
+
+        auto parents(es.selection.run(l));
+        auto off(es.recombination.run(parents));
+        es.replacement.run(parents, std::move(off), &partial[w]);
+
+        ++produced;
+      }
+  });
+
+  if (threads == 1)
+  {
+    // No thread is launched. The random stream of the calling thread is
+    // preserved, so the evolution doesn't depend on where the worker runs.
+    const auto caller_engine(random::engine);
+    worker(0);
+    random::engine = caller_engine;
+  }
+  else
+  {
+    std::vector<std::future<void>> workers;
+    for (unsigned w(0); w < threads; ++w)
+      workers.push_back(std::async(std::launch::async, worker, w));
+
+    wait_workers(workers, produced, &stop, run_count, from_last_msg);
+  }
+
+  const auto before(stats_.best.score.fitness);
+  for (const auto &p : partial)
+  {
+    stats_.crossovers += p.crossovers;
+    stats_.mutations += p.mutations;
+
+    if (p.best.score.fitness > stats_.best.score.fitness)
+    {
+      stats_.best = p.best;
+      stats_.last_imp = p.last_imp;
+    }
+  }
+
+  if (stats_.best.score.fitness != before)
+    print_progress(pop_.individuals(), run_count, true, from_last_msg);
+
+  return stop;
+}
+
 ///
 /// The evolutionary core loop.
 ///
@@ -282,6 +538,12 @@ void evolution<T, ES>::print_progress(unsigned k, unsigned run_count,
 /// With any luck, it will produce an individual that solves the problem at
 /// hand.
 ///
+/// When `environment::threads > 1` (and the evolution strategy supports it)
+/// selection and recombination are performed by concurrent workers (see
+/// `concurrent_generation`). Island model strategies evolve islands on
+/// concurrent workers (see `island_generation`). The evaluator must then be
+/// safe to call from multiple threads.
+///
 /// \note
 /// The return value is a partial summary: the `measurement` section is only
 /// partially filled (fitness) since many metrics are expensive to calculate
@@ -303,6 +565,25 @@ const summary<T> &evolution<T, ES>::run(unsigned run_count, S shake)
   bool stop(false);
   term::set();
 
+  auto threads(pop_.get_problem().env.threads);
+  if (threads > 1 && !ES<T>::is_concurrent && !ES<T>::is_island)
+  {
+    vitaWARNING << "Evolution strategy doesn't support concurrent workers";
+    threads = 1;
+  }
+  if (threads > 1 && !concurrent_)
+  {
+    vitaWARNING << "Evaluator doesn't support concurrent workers";
+    threads = 1;
+  }
+
+  // Concurrent workers share the evaluator, that mustn't change the training
+  // data. The mode is switched only if required (concurrent runs set it in
+  // advance, see `search::run_concurrently`).
+  const bool switch_read_only(threads > 1 && !eva_.read_only());
+  if (switch_read_only)
+    eva_.read_only(true);
+
   es_.init();  // customizatin point for strategy-specific initialization
 
   for (stats_.gen = 0; !stop_condition(stats_) && !stop;  ++stats_.gen)
@@ -311,38 +592,52 @@ const summary<T> &evolution<T, ES>::run(unsigned run_count, S shake)
     {
       // The `shake` functions clear cached fitness values (they refer to the
       // previous dataset). So we must recalculate the fitness of the best
-      // individual found.
+      // individual found and forget the fitness stored in the population.
       assert(!stats_.best.solution.empty());
       stats_.best.score.fitness = eva_(stats_.best.solution);
+      pop_.clear_fitness();
 
       print_progress(0, run_count, true, &from_last_msg);
     }
 
+    // Evaluates new individuals (e.g. first generation, ALPS layers) so that
+    // the generation only reads the fitness stored in the population.
+    pop_.evaluate(eva_);
+
     stats_.az = get_stats();
     log_evolution(run_count);
 
-    for (unsigned k(0); k < pop_.individuals() && !stop; ++k)
+    if constexpr (ES<T>::is_island)
+      stop = island_generation(threads, run_count, &from_last_msg);
+    else if (threads > 1)
     {
-      if (from_last_msg.elapsed() > std::chrono::seconds(2))
+      // Other strategies fall back to a single worker (see above).
+      if constexpr (ES<T>::is_concurrent)
+        stop = concurrent_generation(threads, run_count, &from_last_msg);
+    }
+    else
+      for (unsigned k(0); k < pop_.individuals() && !stop; ++k)
       {
-        print_progress(k, run_count, false, &from_last_msg);
+        if (from_last_msg.elapsed() > std::chrono::seconds(2))
+        {
+          print_progress(k, run_count, false, &from_last_msg);
 
-        stop = term::user_stop();
-      }
+          stop = term::user_stop();
+        }
 
-      // --------- SELECTION ---------
-      auto parents(es_.selection.run());
+        // --------- SELECTION ---------
+        auto parents(es_.selection.run());
 
-      // --------- CROSSOVER / MUTATION ---------
-      auto off(es_.recombination.run(parents));
+        // --------- CROSSOVER / MUTATION ---------
+        auto off(es_.recombination.run(parents));
 
-      // --------- REPLACEMENT --------
-      const auto before(stats_.best.score.fitness);
-      es_.replacement.run(parents, off, &stats_);
+        // --------- REPLACEMENT --------
+        const auto before(stats_.best.score.fitness);
+        es_.replacement.run(parents, std::move(off), &stats_);
 
-      if (stats_.best.score.fitness != before)
-        print_progress(k, run_count, true, &from_last_msg);
-    }
+        if (stats_.best.score.fitness != before)
+          print_progress(k, run_count, true, &from_last_msg);
+      }
 
     stats_.elapsed = measure.elapsed();
 
@@ -355,6 +650,9 @@ const summary<T> &evolution<T, ES>::run(unsigned run_count, S shake)
            << std::chrono::duration<double>(stats_.elapsed).count()
            << "s" << std::string(10, ' ');
 
+  if (switch_read_only)
+    eva_.read_only(false);
+
   term::reset();
   return stats_;
 }
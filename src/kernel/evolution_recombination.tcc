@@ -91,20 +91,24 @@ typename strategy<T>::offspring_t base<T>::run(
         const auto fit_tmp(this->eva_.fast(tmp));
         if (fit_tmp > fit_off)
         {
-          off     =     tmp;
-          fit_off = fit_tmp;
+          off     = std::move(tmp);
+          fit_off =      fit_tmp;
         }
       }
     }
 
-    return {off};
+    typename strategy<T>::offspring_t ret;
+    ret.emplace_back(std::move(off));
+    return ret;
   }
 
   // !crossover
   T off(pop[random::boolean() ? r1 : r2]);
   this->stats_->mutations += off.mutation(p_mutation, prob);
 
-  return {off};
+  typename strategy<T>::offspring_t ret;
+  ret.emplace_back(std::move(off));
+  return ret;
 }
 
 ///
@@ -128,7 +132,9 @@ typename strategy<T>::offspring_t de<T>::run(
   const auto a(pickup(pop, parent[0]));
   const auto b(pickup(pop, parent[0]));
 
-  return {pop[parent[0]].crossover(env.p_cross, env.de.weight,
-                                   pop[parent[1]], pop[a], pop[b])};
+  typename strategy<T>::offspring_t ret;
+  ret.emplace_back(pop[parent[0]].crossover(env.p_cross, env.de.weight,
+                                            pop[parent[1]], pop[a], pop[b]));
+  return ret;
 }
 #endif  // include guard
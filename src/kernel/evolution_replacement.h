@@ -26,6 +26,9 @@ namespace vita::replacement
 /// In the strategy design pattern, this class is the strategy interface and
 /// vita::evolution is the context.
 ///
+/// The `run` method of a replacement strategy takes the offspring by value:
+/// they're moved (not copied) into the population.
+///
 /// \see
 /// - <http://en.wikipedia.org/wiki/Strategy_pattern>
 ///
@@ -68,7 +71,7 @@ public:
   using family_competition::strategy::strategy;
 
   void run(const typename strategy<T>::parents_t &,
-           const typename strategy<T>::offspring_t &, summary<T> *);
+           typename strategy<T>::offspring_t, summary<T> *);
 };
 
 ///
@@ -89,8 +92,15 @@ class tournament : public strategy<T>
 public:
   using tournament::strategy::strategy;
 
+  [[nodiscard]] race_result evaluate(const typename strategy<T>::parents_t &,
+                                     const typename strategy<T>::offspring_t &,
+                                     const summary<T> &) const;
+
+  void run(const typename strategy<T>::parents_t &,
+           typename strategy<T>::offspring_t, summary<T> *);
   void run(const typename strategy<T>::parents_t &,
-           const typename strategy<T>::offspring_t &, summary<T> *);
+           typename strategy<T>::offspring_t, const race_result &,
+           summary<T> *);
 };
 
 ///
@@ -117,13 +127,13 @@ public:
   using alps::strategy::strategy;
 
   void run(const typename strategy<T>::parents_t &,
-           const typename strategy<T>::offspring_t &, summary<T> *);
+           typename strategy<T>::offspring_t, summary<T> *);
 
   void try_move_up_layer(unsigned);
 
 private:
   [[nodiscard]] unsigned allowed_age(unsigned) const;
-  bool try_add_to_layer(unsigned, const T &);
+  bool try_add_to_layer(unsigned, const T &, const fitness_t &);
 };
 
 template<class T>
@@ -133,7 +143,7 @@ public:
   using pareto::strategy::strategy;
 
   void run(const typename strategy<T>::parents_t &,
-           const typename strategy<T>::offspring_t &, summary<T> *);
+           typename strategy<T>::offspring_t, summary<T> *);
 };
 
 #include "kernel/evolution_replacement.tcc"
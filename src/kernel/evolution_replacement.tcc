@@ -39,7 +39,7 @@ strategy<T>::strategy(population<T> &pop, evaluator<T> &eva) : pop_(pop),
 template<class T>
 void family_competition<T>::run(
   const typename strategy<T>::parents_t &parent,
-  const typename strategy<T>::offspring_t &offspring, summary<T> *s)
+  typename strategy<T>::offspring_t offspring, summary<T> *s)
 {
   auto &pop(this->pop_);
   const auto elitism(pop.get_problem().env.elitism);
@@ -49,7 +49,7 @@ void family_competition<T>::run(
 
   const fitness_t fit_parent[] =
   {
-    this->eva_(pop[parent[0]]), this->eva_(pop[parent[1]])
+    pop.fitness(parent[0], this->eva_), pop.fitness(parent[1], this->eva_)
   };
   const unsigned id_worst(fit_parent[0] < fit_parent[1] ? 0 : 1);
 
@@ -57,10 +57,22 @@ void family_competition<T>::run(
   assert((fit_off[0] <= 0.0) == (fit_parent[0][0] <= 0.0));
   assert((fit_off[0] <= 0.0) == (fit_parent[1][0] <= 0.0));
 
+  // The summary is updated before `offspring[0]` is moved into the
+  // population.
+  if (fit_off > s->best.score.fitness)
+  {
+    s->last_imp           = s->gen;
+    s->best.solution      = offspring[0];
+    s->best.score.fitness = fit_off;
+  }
+
   if (elitism == trilean::yes)
   {
     if (fit_off > fit_parent[id_worst])
-      pop[parent[id_worst]] = offspring[0];
+    {
+      pop[parent[id_worst]] = std::move(offspring[0]);
+      pop.store_fitness(parent[id_worst], fit_off);
+    }
   }
   else  // !elitism
   {
@@ -72,23 +84,22 @@ void family_competition<T>::run(
     double replace(1.0 - (fit_off[0]
                           / (fit_off[0] + fit_parent[id_worst][0])));
     if (random::boolean(replace))
-      pop[parent[id_worst]] = offspring[0];
+    {
+      pop[parent[id_worst]] = std::move(offspring[0]);
+      pop.store_fitness(parent[id_worst], fit_off);
+    }
     else
     {
       //replace = 1.0 / (1.0 + exp(f_parent[!id_worst][0] - fit_off[0]));
       replace = 1.0 - (fit_off[0] / (fit_off[0] + fit_parent[!id_worst][0]));
 
       if (random::boolean(replace))
-        pop[parent[!id_worst]] = offspring[0];
+      {
+        pop[parent[!id_worst]] = std::move(offspring[0]);
+        pop.store_fitness(parent[!id_worst], fit_off);
+      }
     }
   }
-
-  if (fit_off > s->best.score.fitness)
-  {
-    s->last_imp           = s->gen;
-    s->best.solution      = offspring[0];
-    s->best.score.fitness = fit_off;
-  }
 }
 
 ///
@@ -106,25 +117,97 @@ void family_competition<T>::run(
 /// - elitism is `true` => child replaces a member of the population only if
 ///   child is better.
 ///
+/// With elitism the evaluation of the child can be interrupted as soon as
+/// it's proven that the child is neither better than the individual to be
+/// replaced nor better than the best individual found (see
+/// `evaluator::race`).
+///
 template<class T>
 void tournament<T>::run(
   const typename strategy<T>::parents_t &parent,
-  const typename strategy<T>::offspring_t &offspring, summary<T> *s)
+  typename strategy<T>::offspring_t offspring, summary<T> *s)
 {
-  auto &pop(this->pop_);
+  run(parent, std::move(offspring), {fitness_t(), false}, s);
+}
+
+///
+/// Evaluates the offspring in advance.
+///
+/// \param[in] parent    coordinates of the candidate parents (see `run`)
+/// \param[in] offspring vector of the "children"
+/// \param[in] s         statistical summary
+/// \return              the (possibly interrupted) evaluation of the child
+///
+/// The evaluation (including the race, with elitism) is the one `run` would
+/// perform given the current population and summary. It only reads the
+/// population, so many workers can call it at the same time (see
+/// `evolution::concurrent_generation`) and pass the result to `run`.
+///
+template<class T>
+race_result tournament<T>::evaluate(
+  const typename strategy<T>::parents_t &parent,
+  const typename strategy<T>::offspring_t &offspring,
+  const summary<T> &s) const
+{
+  const auto &pop(this->pop_);
   const auto elitism(pop.get_problem().env.elitism);
   Expects(elitism != trilean::unknown);
 
-  const auto fit_off(this->eva_(offspring[0]));
+  if (elitism == trilean::yes)
+    return this->eva_.race(offspring[0],
+                           std::min(pop.fitness(parent.back(), this->eva_),
+                                    s.best.score.fitness));
+
+  return {this->eva_(offspring[0]), true};
+}
+
+///
+/// \param[in]     parent    coordinates of the candidate parents (see the
+///                          other `run`)
+/// \param[in]     offspring vector of the "children"
+/// \param[in]     pre       evaluation of the child performed in advance
+///                          (see `evaluate`)
+/// \param[in,out] s         statistical summary
+///
+/// Same as the other `run` but the child isn't evaluated again when `pre` is
+/// still meaningful: an exact evaluation always is, an interrupted one only
+/// if it proves that the child cannot beat the current bound (the population
+/// and the summary may have changed after `evaluate`).
+///
+template<class T>
+void tournament<T>::run(
+  const typename strategy<T>::parents_t &parent,
+  typename strategy<T>::offspring_t offspring, const race_result &pre,
+  summary<T> *s)
+{
+  auto &pop(this->pop_);
+  const auto elitism(pop.get_problem().env.elitism);
+  Expects(elitism != trilean::unknown);
 
   // In old versions of Vita, the individual to be replaced was chosen with
   // an ad-hoc kill tournament.
   const auto rep_idx(parent.back());
-  const auto f_rep_idx(this->eva_(pop[rep_idx]));
-  const bool replace(f_rep_idx < fit_off);
 
-  if (elitism == trilean::no || replace)
-    pop[rep_idx] = offspring[0];
+  fitness_t fit_off;
+  bool replace(true);
+
+  if (elitism == trilean::yes)
+  {
+    const auto f_rep_idx(pop.fitness(rep_idx, this->eva_));
+    const auto bound(std::min(f_rep_idx, s->best.score.fitness));
+
+    const auto off(pre.exact || (pre.fitness.size() && pre.fitness <= bound)
+                   ? pre : this->eva_.race(offspring[0], bound));
+
+    // An interrupted evaluation proves that the child is a loser.
+    if (!off.exact)
+      return;
+
+    fit_off = off.fitness;
+    replace = f_rep_idx < fit_off;
+  }
+  else
+    fit_off = pre.exact ? pre.fitness : this->eva_(offspring[0]);
 
   if (fit_off > s->best.score.fitness)
   {
@@ -132,6 +215,12 @@ void tournament<T>::run(
     s->best.solution      = offspring[0];
     s->best.score.fitness = fit_off;
   }
+
+  if (replace)
+  {
+    pop[rep_idx] = std::move(offspring[0]);
+    pop.store_fitness(rep_idx, fit_off);
+  }
 }
 
 ///
@@ -164,13 +253,15 @@ void alps<T>::try_move_up_layer(unsigned l)
     const auto n(pop.individuals(l));
 
     for (auto i(decltype(n){0}); i < n; ++i)
-      try_add_to_layer(l + 1, pop[{l, i}]);
+      try_add_to_layer(l + 1, pop[{l, i}],
+                       pop.fitness({l, i}, this->eva_));
   }
 }
 
 ///
-/// \param[in] layer a layer
+/// \param[in] layer    a layer
 /// \param[in] incoming an individual
+/// \param[in] f_inc    fitness of `incoming`
 ///
 /// We would like to add `incoming` in layer `layer`. The insertion will
 /// take place if:
@@ -181,7 +272,8 @@ void alps<T>::try_move_up_layer(unsigned l)
 ///   both are simultaneously within/outside the time frame of `layer`.
 ///
 template<class T>
-bool alps<T>::try_add_to_layer(unsigned layer, const T &incoming)
+bool alps<T>::try_add_to_layer(unsigned layer, const T &incoming,
+                               const fitness_t &f_inc)
 {
   using coord = typename population<T>::coord;
 
@@ -191,6 +283,7 @@ bool alps<T>::try_add_to_layer(unsigned layer, const T &incoming)
   if (p.individuals(layer) < p.allowed(layer))
   {
     p.add_to_layer(layer, incoming);  // layer not full... inserting incoming
+    p.store_fitness({layer, p.individuals(layer) - 1}, f_inc);
     return true;
   }
 
@@ -199,13 +292,13 @@ bool alps<T>::try_add_to_layer(unsigned layer, const T &incoming)
 
   // Well, let's see if the worst individual we can find with a tournament...
   coord c_worst{layer, random::sup(p.individuals(layer))};
-  auto f_worst(this->eva_(p[c_worst]));
+  auto f_worst(p.fitness(c_worst, this->eva_));
 
   auto rounds(p.get_problem().env.tournament_size);
   while (rounds--)
   {
     const coord c_x{layer, random::sup(p.individuals(layer))};
-    const auto f_x(this->eva_(p[c_x]));
+    const auto f_x(p.fitness(c_x, this->eva_));
 
     if ((p[c_x].age() > p[c_worst].age() && p[c_x].age() > m_age) ||
         (p[c_worst].age() <= m_age && p[c_x].age() <= m_age &&
@@ -219,11 +312,12 @@ bool alps<T>::try_add_to_layer(unsigned layer, const T &incoming)
   // ... is worse than the incoming individual.
   if ((incoming.age() <= m_age && p[c_worst].age() > m_age) ||
       ((incoming.age() <= m_age || p[c_worst].age() > m_age) &&
-       this->eva_(incoming) >= f_worst))
+       f_inc >= f_worst))
   {
     if (layer + 1 < p.layers())
-      try_add_to_layer(layer + 1, p[c_worst]);
+      try_add_to_layer(layer + 1, p[c_worst], f_worst);
     p[c_worst] = incoming;
+    p.store_fitness(c_worst, f_inc);
 
     return true;
   }
@@ -246,7 +340,7 @@ bool alps<T>::try_add_to_layer(unsigned layer, const T &incoming)
 template<class T>
 void alps<T>::run(
   const typename strategy<T>::parents_t &parent,
-  const typename strategy<T>::offspring_t &offspring, summary<T> *s)
+  typename strategy<T>::offspring_t offspring, summary<T> *s)
 {
   const auto layer(std::max(parent[0].layer, parent[1].layer));
   const auto f_off(this->eva_(offspring[0]));
@@ -263,10 +357,11 @@ void alps<T>::run(
   // the population.
   // See "Exploiting The Path of Least Resistance In Evolution" (Gearoid Murphy
   // and Conor Ryan).
-  if (f_off > this->eva_(pop[parent[0]]) && f_off > this->eva_(pop[parent[1]]))
+  if (f_off > pop.fitness(parent[0], this->eva_)
+      && f_off > pop.fitness(parent[1], this->eva_))
 #endif
   {
-    ins = try_add_to_layer(layer, offspring[0]);
+    ins = try_add_to_layer(layer, offspring[0], f_off);
   }
 
   if (f_off > s->best.score.fitness)
@@ -279,7 +374,7 @@ void alps<T>::run(
     // There isn't an age limit for the last layer so try_add_to_layer will
     // always succeed.
     if (!ins && elitism == trilean::yes)
-      try_add_to_layer(pop.layers() - 1, offspring[0]);
+      try_add_to_layer(pop.layers() - 1, offspring[0], f_off);
 
     s->last_imp           = s->gen;
     s->best.solution      = offspring[0];
@@ -316,7 +411,7 @@ void alps<T>::run(
 template<class T>
 void pareto<T>::run(
   const typename strategy<T>::parents_t &parent,
-  const typename strategy<T>::offspring_t &offspring, summary<T> *s)
+  typename strategy<T>::offspring_t offspring, summary<T> *s)
 {
   auto &pop(this->pop_);
   const auto elitism(pop.get_problem().env.elitism);
@@ -348,7 +443,7 @@ void pareto<T>::run(
   bool dominated(false);
   for (const auto &i : parent)
   {
-    const auto fit_i(this->eva_(pop[i]));
+    const auto fit_i(pop.fitness(i, this->eva_));
 
     if (fit_i.dominating(fit_off))
     {
@@ -357,14 +452,17 @@ void pareto<T>::run(
     }
   }
 
-  if (elitism == trilean::no || !dominated)
-    pop[parent.back()] = offspring[0];
-
   if (fit_off > s->best.score.fitness)
   {
     s->last_imp           = s->gen;
     s->best.solution      = offspring[0];
     s->best.score.fitness = fit_off;
   }
+
+  if (elitism == trilean::no || !dominated)
+  {
+    pop[parent.back()] = std::move(offspring[0]);
+    pop.store_fitness(parent.back(), fit_off);
+  }
 }
 #endif  // Include guard
@@ -73,6 +73,11 @@ public:
   using tournament::strategy::strategy;
 
   typename strategy<T>::parents_t run();
+  typename strategy<T>::parents_t run(unsigned);
+
+private:
+  [[nodiscard]] typename strategy<T>::parents_t around(
+    typename population<T>::coord) const;
 };
 
 ///
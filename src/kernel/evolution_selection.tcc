@@ -54,14 +54,43 @@ strategy<T>::strategy(const population<T> &pop, evaluator<T> &eva,
 ///
 template<class T>
 typename strategy<T>::parents_t tournament<T>::run()
+{
+  return around(pickup(this->pop_));
+}
+
+///
+/// \param[in] l a layer
+/// \return      a collection of coordinates of individuals of layer `l`
+///              ordered in descending fitness
+///
+/// Same as `run()` but the tournament is restricted to layer `l` (used when
+/// layers are evolved independently, e.g. by vita::island_es).
+///
+template<class T>
+typename strategy<T>::parents_t tournament<T>::run(unsigned l)
+{
+  const auto &pop(this->pop_);
+  Expects(l < pop.layers());
+
+  return around({l, vita::random::sup(pop.individuals(l))});
+}
+
+///
+/// \param[in] target coordinates of a reference individual
+/// \return           a collection of coordinates of individuals near `target`
+///                   ordered in descending fitness
+///
+template<class T>
+typename strategy<T>::parents_t tournament<T>::around(
+  typename population<T>::coord target) const
 {
   const auto &pop(this->pop_);
 
   const auto rounds(pop.get_problem().env.tournament_size);
   assert(rounds);
 
-  const auto target(pickup(pop));
   typename strategy<T>::parents_t ret(rounds);
+  std::vector<fitness_t> fit(rounds);
 
   // This is the inner loop of an insertion sort algorithm. It's simple, fast
   // (if `rounds` is small) and doesn't perform too much comparisons.
@@ -69,21 +98,25 @@ typename strategy<T>::parents_t tournament<T>::run()
   for (unsigned i(0); i < rounds; ++i)
   {
     const auto new_coord(pickup(pop, target));
-    const auto new_fitness(this->eva_(pop[new_coord]));
+    const auto new_fitness(pop.fitness(new_coord, this->eva_));
 
     auto j(i);
 
-    for (; j && new_fitness > this->eva_(pop[ret[j - 1]]); --j)
+    for (; j && new_fitness > fit[j - 1]; --j)
+    {
       ret[j] = ret[j - 1];
+      fit[j] = fit[j - 1];
+    }
 
     ret[j] = new_coord;
+    fit[j] = new_fitness;
   }
 
 #if !defined(NDEBUG)
   assert(ret.size() == rounds);
 
   for (unsigned i(1); i < rounds; ++i)
-    assert(this->eva_(pop[ret[i - 1]]) >= this->eva_(pop[ret[i]]));
+    assert(fit[i - 1] >= fit[i]);
 #endif
 
   return ret;
@@ -137,8 +170,8 @@ typename strategy<T>::parents_t alps<T>::run()
   // This type is used to take advantage of the lexicographic comparison
   // capabilities of std::pair.
   using age_fit_t = std::pair<bool, fitness_t>;
-  age_fit_t age_fit0{!aged(c0), this->eva_(pop[c0])};
-  age_fit_t age_fit1{!aged(c1), this->eva_(pop[c1])};
+  age_fit_t age_fit0{!aged(c0), pop.fitness(c0, this->eva_)};
+  age_fit_t age_fit1{!aged(c1), pop.fitness(c1, this->eva_)};
 
   if (age_fit0 < age_fit1)
   {
@@ -155,7 +188,7 @@ typename strategy<T>::parents_t alps<T>::run()
   while (rounds--)
   {
     const auto tmp(this->pickup(layer, same_layer_p));
-    const age_fit_t tmp_age_fit{!aged(tmp), this->eva_(pop[tmp])};
+    const age_fit_t tmp_age_fit{!aged(tmp), pop.fitness(tmp, this->eva_)};
 
     if (age_fit0 < tmp_age_fit)
     {
@@ -173,8 +206,8 @@ typename strategy<T>::parents_t alps<T>::run()
 
     assert(age_fit0.first == !aged(c0));
     assert(age_fit1.first == !aged(c1));
-    assert(age_fit0.second == this->eva_(pop[c0]));
-    assert(age_fit1.second == this->eva_(pop[c1]));
+    assert(age_fit0.second == pop.fitness(c0, this->eva_));
+    assert(age_fit1.second == pop.fitness(c1, this->eva_));
     assert(age_fit0 >= age_fit1);
     assert(!aged(c0) || aged(c1));
     assert(c0.layer <= layer);
@@ -237,13 +270,13 @@ void pareto<T>::front(const std::vector<unsigned> &pool,
     if (fs->find(ind) != fs->end() || ds->find(ind) != ds->end())
       continue;
 
-    const auto ind_fit(this->eva_(pop[{0, ind}]));
+    const auto ind_fit(pop.fitness({0, ind}, this->eva_));
 
     bool ind_dominated(false);
     for (auto f(fs->cbegin()); f != fs->cend() && !ind_dominated;)
       // no increment in the for loop
     {
-      const auto f_fit(this->eva_(pop[{0, *f}]));
+      const auto f_fit(pop.fitness({0, *f}, this->eva_));
 
       if (!ind_dominated && ind_fit.dominating(f_fit))
       {
@@ -79,6 +79,17 @@ public:
   static constexpr bool is_de =
     std::is_same<CS<T>, typename vita::recombination::de<T>>::value;
 
+  /// `true` if layers are evolved independently (islands) and only
+  /// periodically exchange individuals (see vita::island_es).
+  static constexpr bool is_island = false;
+
+  /// `true` if selection and recombination can be performed by concurrent
+  /// workers sharing the same population (see `environment::threads`).
+  static constexpr bool is_concurrent =
+    std::is_same<SS<T>, typename vita::selection::tournament<T>>::value &&
+    std::is_same<CS<T>, typename vita::recombination::base<T>>::value &&
+    std::is_same<RS<T>, typename vita::replacement::tournament<T>>::value;
+
 public:
   SS<T> selection;
   CS<T> recombination;
@@ -166,6 +177,41 @@ public:
   static environment shape(environment);
 };
 
+///
+/// Island model evolution strategy.
+///
+/// Every layer of the population is an island: a sub-population evolved by a
+/// standard (tournament based) strategy, independently from the others.
+/// Every `environment::island.migration_interval` generations islands send
+/// copies of their best individuals to neighbour islands (according to
+/// `environment::island.topology`), where they replace the worst ones.
+///
+/// Islands only interact at migration time, so they're evolved by concurrent
+/// workers (see `environment::threads`). Migration preserves diversity and
+/// counteracts the premature convergence of a single, panmictic population.
+///
+template<class T>
+class island_es : public evolution_strategy<T,
+                                            selection::tournament,
+                                            recombination::base,
+                                            replacement::tournament>
+{
+public:
+  island_es(population<T> &, evaluator<T> &, summary<T> *);
+
+  void after_generation();
+
+  static environment shape(environment);
+
+  static constexpr bool is_island = true;
+
+private:
+  [[nodiscard]] std::vector<unsigned> neighbours(unsigned) const;
+  [[nodiscard]] std::vector<unsigned> sorted(unsigned) const;
+
+  evaluator<T> &eva_;
+};
+
 ///
 /// Differential evolution strategy.
 ///
@@ -56,6 +56,143 @@ bool std_es<T>::stop_condition() const
   return false;
 }
 
+///
+/// \param[in] pop the population (every layer is an island)
+/// \param[in] eva current evaluator
+/// \param[in] s   up to date summary of the evolution
+///
+template<class T>
+island_es<T>::island_es(population<T> &pop, evaluator<T> &eva, summary<T> *s)
+  : island_es::evolution_strategy(pop, eva, s), eva_(eva)
+{
+}
+
+///
+/// \param[out] env environment
+/// \return         a strategy-specific environment
+///
+/// \remark The island model requires more than one layer.
+///
+template<class T>
+environment island_es<T>::shape(environment env)
+{
+  env.layers = 4;
+  return env;
+}
+
+///
+/// \param[in] l an island
+/// \return      the islands receiving migrants from island `l`
+///
+template<class T>
+std::vector<unsigned> island_es<T>::neighbours(unsigned l) const
+{
+  const auto islands(this->pop_.layers());
+  Expects(l < islands);
+  Expects(islands > 1);
+
+  switch (this->pop_.get_problem().env.island.topology)
+  {
+  case island::topology::random:
+    {
+      // A random island different from `l`.
+      const auto n(random::sup(islands - 1));
+      return {n < l ? n : n + 1};
+    }
+
+  case island::topology::complete:
+    {
+      std::vector<unsigned> ret;
+      for (unsigned i(0); i < islands; ++i)
+        if (i != l)
+          ret.push_back(i);
+      return ret;
+    }
+
+  default:  // island::topology::ring
+    return {(l + 1) % islands};
+  }
+}
+
+///
+/// \param[in] l an island
+/// \return      indices of the individuals of island `l` ordered in
+///              descending fitness
+///
+template<class T>
+std::vector<unsigned> island_es<T>::sorted(unsigned l) const
+{
+  const auto &pop(this->pop_);
+
+  const auto n(pop.individuals(l));
+  std::vector<unsigned> idx(n);
+  std::vector<fitness_t> fit(n);
+  for (unsigned i(0); i < n; ++i)
+  {
+    idx[i] = i;
+    fit[i] = pop.fitness({l, i}, eva_);
+  }
+
+  std::stable_sort(idx.begin(), idx.end(),
+                   [&fit](unsigned i1, unsigned i2)
+                   {
+                     return fit[i1] > fit[i2];
+                   });
+
+  return idx;
+}
+
+///
+/// Migration: every `migration_interval` generations islands send copies of
+/// their best individuals to neighbour islands.
+///
+/// Migrants are chosen before any island changes, so the result doesn't
+/// depend on the order islands are processed. Immigrants replace the worst
+/// individuals of the receiving island.
+///
+template<class T>
+void island_es<T>::after_generation()
+{
+  const auto &sum(this->sum_);
+  auto &pop(this->pop_);
+  const auto &env(pop.get_problem().env);
+
+  const auto islands(pop.layers());
+  const auto interval(env.island.migration_interval);
+
+  if (islands < 2 || !interval || !sum->gen || sum->gen % interval)
+    return;
+
+  std::vector<std::vector<std::pair<T, fitness_t>>> immigrants(islands);
+  for (unsigned l(0); l < islands; ++l)
+  {
+    const auto best(sorted(l));
+    const auto n(std::min<std::size_t>(env.island.migrants, best.size()));
+
+    for (const auto dest : neighbours(l))
+      for (std::size_t i(0); i < n; ++i)
+        immigrants[dest].emplace_back(pop[{l, best[i]}],
+                                      pop.fitness({l, best[i]}, eva_));
+  }
+
+  for (unsigned l(0); l < islands; ++l)
+  {
+    const auto order(sorted(l));
+
+    // At least the best individual of the island survives.
+    const auto n(std::min<std::size_t>(immigrants[l].size(),
+                                       order.size() - 1));
+
+    for (std::size_t i(0); i < n; ++i)
+    {
+      const typename population<T>::coord c{l, order[order.size() - 1 - i]};
+
+      pop[c] = immigrants[l][i].first;
+      pop.store_fitness(c, immigrants[l][i].second);
+    }
+  }
+}
+
 ///
 /// \param[out] env environemnt
 /// \return         a strategy-specific environment
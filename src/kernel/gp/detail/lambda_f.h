@@ -44,6 +44,8 @@ public:
   explicit reg_lambda_f_storage(const reg_lambda_f_storage &rls)
     : ind_(rls.ind_), int_(src_interpreter<T>(&ind_))
   {
+    int_.share_native(rls.int_);
+
     Ensures(is_valid());
   }
 
@@ -64,6 +66,7 @@ public:
     {
       ind_ = rhs.ind_;
       int_ = src_interpreter<T>(&ind_);
+      int_.share_native(rhs.int_);
     }
 
     Ensures(is_valid());
@@ -93,6 +96,11 @@ public:
     return &int_.program() == &ind_;
   }
 
+  bool compile_native(const std::filesystem::path &dir)
+  {
+    return int_.compile_native(dir);
+  }
+
   // Serialization.
   bool save(std::ostream &out) const { return ind_.save(out); }
 
@@ -116,6 +124,11 @@ public:
 
   bool is_valid() const { return true; }
 
+  bool compile_native(const std::filesystem::path &dir)
+  {
+    return int_.compile_native(dir);
+  }
+
   // Serialization
   bool save(std::ostream &out) const
   {
@@ -158,6 +171,15 @@ public:
     return true;
   }
 
+  bool compile_native(const std::filesystem::path &dir)
+  {
+    bool ret(true);
+    for (auto &lambda : team_)
+      ret = lambda.compile_native(dir) && ret;
+
+    return ret;
+  }
+
   // Serialization.
   bool save(std::ostream &o) const
   {
@@ -29,10 +29,69 @@ namespace vita
 ///
 /// The class `gene` is the building block of a `i_mep` individual.
 ///
+/// Genes are compact and trivially copyable (a genome is copied via
+/// `memcpy`): the arguments of a function are packed in a fixed-size array
+/// sharing its storage with the parameter of a terminal (a gene has either
+/// arguments or a parameter).
+///
+/// \warning
+/// `args` is meaningful only for functions, `par` only for terminals.
+///
 template<unsigned K>
 class basic_gene
 {
 public:
+  // Types and constants.
+  using packed_index_t = std::uint16_t;
+
+  enum : decltype(K) {k_args = K};
+
+  ///
+  /// The arguments of a function: a fixed-capacity array of indices.
+  ///
+  class arg_pack
+  {
+  public:
+    arg_pack() = default;
+
+    /// \param[in] n number of arguments (at most `K`), initially `0`
+    explicit arg_pack(std::size_t n)
+      : idx_(), size_(static_cast<std::uint8_t>(n))
+    {
+      Expects(n <= K);
+    }
+
+    /// \param[in] n the new number of arguments (at most `K`)
+    void resize(std::size_t n)
+    {
+      Expects(n <= K);
+      size_ = static_cast<std::uint8_t>(n);
+    }
+
+    /// \return the number of arguments
+    [[nodiscard]] std::size_t size() const { return size_; }
+
+    packed_index_t &operator[](std::size_t i)
+    {
+      assert(i < size());
+      return idx_[i];
+    }
+    const packed_index_t &operator[](std::size_t i) const
+    {
+      assert(i < size());
+      return idx_[i];
+    }
+
+    packed_index_t *begin() { return idx_; }
+    packed_index_t *end() { return idx_ + size_; }
+    const packed_index_t *begin() const { return idx_; }
+    const packed_index_t *end() const { return idx_ + size_; }
+
+  private:
+    packed_index_t idx_[K];
+    std::uint8_t size_;
+  };
+
   basic_gene() {}
   explicit basic_gene(const terminal &);
   basic_gene(const std::pair<symbol *, std::vector<index_t>> &);
@@ -41,16 +100,13 @@ public:
   [[nodiscard]] locus locus_of_argument(std::size_t) const;
   small_vector<locus, K> arguments() const;
 
-  // Types and constants.
-  using packed_index_t = std::uint16_t;
-  using arg_pack = small_vector<packed_index_t, K>;
-
-  enum : decltype(K) {k_args = K};
-
   // Public data members.
-  const symbol    *sym;
-  terminal_param_t par;
-  arg_pack        args;
+  const symbol *sym;
+  union
+  {
+    terminal_param_t par;  // terminals
+    arg_pack args;         // functions
+  };
 
 private:
   void init_if_parametric();
@@ -67,10 +123,13 @@ bool operator!=(const basic_gene<K> &, const basic_gene<K> &);
 ///
 /// A basic_gene with the standard size.
 ///
-/// A gene supports functions with more than 4 arguments (with a performance
-/// penality).
+/// A gene supports functions with up to 7 arguments: their indices fill the
+/// storage of the parameter of a terminal (a gene takes 24 bytes on 64-bit
+/// systems).
 ///
-using gene = basic_gene<4>;
+using gene = basic_gene<7>;
+
+static_assert(std::is_trivially_copyable_v<gene>);
 
 #include "kernel/gp/gene.tcc"
 }  // namespace vita
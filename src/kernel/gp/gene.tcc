@@ -26,7 +26,7 @@
 /// This is usually called for filling the patch section of an individual.
 ///
 template<unsigned K>
-basic_gene<K>::basic_gene(const terminal &t) : sym(&t), par(), args(0)
+basic_gene<K>::basic_gene(const terminal &t) : sym(&t), par()
 {
   init_if_parametric();
 }
@@ -59,10 +59,12 @@ void basic_gene<K>::init_if_parametric()
 ///
 template<unsigned K>
 basic_gene<K>::basic_gene(const std::pair<symbol *, std::vector<index_t>> &g)
-  : sym(g.first), args(g.first->arity())
+  : sym(g.first), par()
 {
   if (sym->arity())
   {
+    args = arg_pack(sym->arity());
+
     std::transform(g.second.begin(), g.second.end(), args.begin(),
                    [](index_t i)
                    {
@@ -86,12 +88,14 @@ basic_gene<K>::basic_gene(const std::pair<symbol *, std::vector<index_t>> &g)
 ///
 template<unsigned K>
 basic_gene<K>::basic_gene(const symbol &s, index_t from, index_t sup)
-  : sym(&s), args(s.arity())
+  : sym(&s), par()
 {
   Expects(from < sup);
 
   if (s.arity())
   {
+    args = arg_pack(s.arity());
+
     assert(sup <= std::numeric_limits<packed_index_t>::max());
 
     std::generate(args.begin(), args.end(),
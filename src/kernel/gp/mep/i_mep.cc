@@ -11,6 +11,8 @@
  */
 
 #include <algorithm>
+#include <array>
+#include <cstring>
 #include <functional>
 #include <map>
 #include <utility>
@@ -32,7 +34,8 @@ namespace vita
 ///
 i_mep::i_mep(const problem &p)
   : individual(), genome_(p.env.mep.code_length, p.sset.categories()),
-    best_{0, 0}, active_crossover_type_(random::sup(NUM_CROSSOVERS))
+    hashes_(genome_.rows(), genome_.cols()), best_{0, 0},
+    active_crossover_type_(random::sup(NUM_CROSSOVERS))
 {
   Expects(size());
   Expects(p.env.mep.patch_length);
@@ -70,6 +73,7 @@ i_mep::i_mep(const std::vector<gene> &gv)
                              {
                                return g1.sym->category() < g2.sym->category();
                              })->sym->category() + 1),
+    hashes_(genome_.rows(), genome_.cols()),
     best_{0, 0},
     active_crossover_type_(random::sup(NUM_CROSSOVERS))
 {
@@ -102,7 +106,61 @@ i_mep::i_mep(const std::vector<gene> &gv)
 ///
 unsigned i_mep::active_symbols() const
 {
-  return static_cast<unsigned>(std::distance(begin(), end()));
+  return static_cast<unsigned>(exons().size());
+}
+
+///
+/// \return the active loci in ascending order
+///
+/// The list is computed once per change of the genome and cached, so
+/// iterating on the active code (see `begin()`) doesn't allocate memory.
+///
+/// \warning
+/// The reference is invalidated by any change of the individual. Like
+/// `signature()`, the first call after a change updates the cache: it isn't
+/// safe to call it concurrently on a changed individual.
+///
+const std::vector<locus> &i_mep::exons() const
+{
+  if (exons_.empty())
+    scan_exons(exons_);
+
+  return exons_;
+}
+
+///
+/// \param[out] out the active loci in ascending order
+///
+/// Arguments of a gene always have greater indices, so a single forward scan
+/// starting from the best locus finds every active locus.
+///
+void i_mep::scan_exons(std::vector<locus> &out) const
+{
+  out.clear();
+
+  if (empty())
+    return;
+
+  thread_local matrix<char> active;
+  if (active.rows() != genome_.rows() || active.cols() != genome_.cols())
+    active = matrix<char>(genome_.rows(), genome_.cols());
+  else
+    active.fill(false);
+
+  active(best_) = true;
+
+  const index_t i_sup(size());
+  const category_t c_sup(categories());
+  for (index_t i(best_.index); i < i_sup; ++i)
+    for (category_t c(0); c < c_sup; ++c)
+      if (const locus l{i, c}; active(l))
+      {
+        out.push_back(l);
+
+        const gene &g(genome_(l));
+        for (unsigned j(0); j < g.sym->arity(); ++j)
+          active(g.locus_of_argument(j)) = true;
+      }
 }
 
 ///
@@ -119,6 +177,7 @@ i_mep i_mep::get_block(const locus &l) const
   if (ret.best_ != l)
   {
     ret.best_ = l;
+    ret.exons_.clear();
     ret.signature_.clear();
   }
 
@@ -138,28 +197,57 @@ unsigned i_mep::mutation(double pgm, const problem &prb)
   Expects(0.0 <= pgm && pgm <= 1.0);
 
   unsigned n(0);
+  index_t changed_sup(0);
 
   const auto i_size(size());
   const auto patch(i_size - prb.env.mep.patch_length);
 
-  for (auto i(begin()); i != end(); ++i)  // here mutation affects only exons
-    if (random::boolean(pgm))
-    {
-      const auto ix(i.locus().index);
-      const auto ct(i.locus().category);
+  // Here mutation affects only exons. Loci are scanned in ascending order and
+  // the arguments of a gene are marked active after its mutation, so the loci
+  // activated by a mutation are considered too (arguments of a gene always
+  // have greater indices).
+  thread_local matrix<char> active;
+  if (active.rows() != genome_.rows() || active.cols() != genome_.cols())
+    active = matrix<char>(genome_.rows(), genome_.cols());
+  else
+    active.fill(false);
 
-      const gene g(ix < patch ? gene(prb.sset.roulette(ct), ix + 1, i_size)
-                              : gene(prb.sset.roulette_terminal(ct)));
+  active(best_) = true;
 
-      if (*i != g)
+  std::vector<locus> visited;
+  const category_t c_sup(categories());
+  for (index_t i(best_.index); i < i_size; ++i)
+    for (category_t c(0); c < c_sup; ++c)
+      if (const locus l{i, c}; active(l))
       {
-        ++n;
-        *i = g;
+        visited.push_back(l);
+
+        if (random::boolean(pgm))
+        {
+          const gene g(i < patch ? gene(prb.sset.roulette(c), i + 1, i_size)
+                                 : gene(prb.sset.roulette_terminal(c)));
+
+          if (genome_(l) != g)
+          {
+            ++n;
+            genome_(l) = g;
+
+            hashes_(l).clear();
+            changed_sup = std::max(changed_sup, i);
+          }
+        }
+
+        const gene &g(genome_(l));
+        for (unsigned j(0); j < g.sym->arity(); ++j)
+          active(g.locus_of_argument(j)) = true;
       }
-    }
 
   if (n)
+  {
+    stale_hashes(changed_sup);
+    exons_ = std::move(visited);  // the visited loci are the new exons
     signature_.clear();
+  }
 
   Ensures(is_valid());
   return n;
@@ -199,7 +287,13 @@ i_mep i_mep::replace(const locus &l, const gene &g) const
 {
   i_mep ret(*this);
 
-  ret.genome_(l) = g;
+  if (ret.genome_(l) != g)
+  {
+    ret.genome_(l) = g;
+    ret.hashes_(l).clear();
+    ret.stale_hashes(l.index);
+    ret.exons_.clear();
+  }
   ret.signature_.clear();
 
   Ensures(ret.is_valid());
@@ -231,8 +325,13 @@ i_mep i_mep::destroy_block(index_t index, const symbol_set &sset) const
   i_mep ret(*this);
   const category_t c_sup(categories());
   for (category_t c(0); c < c_sup; ++c)
+  {
     ret.genome_(index, c) = gene(sset.roulette_terminal(c));
+    ret.hashes_(index, c).clear();
+  }
 
+  ret.stale_hashes(index);
+  ret.exons_.clear();
   ret.signature_.clear();
 
   Ensures(ret.is_valid());
@@ -304,70 +403,116 @@ unsigned distance(const i_mep &lhs, const i_mep &rhs)
 }
 
 ///
-/// Maps syntactically distinct (but logically equivalent) individuals to the
-/// same byte stream.
+/// Maps syntactically distinct (but logically equivalent) expressions to the
+/// same hash.
 ///
-/// \param[in]  l locus in this individual
-/// \param[out] p byte stream compacted version of the gene sequence
-///               starting at locus `l`
+/// \param[in] l locus of a gene in this individual
+/// \param[in] h hashes of the expressions starting at the arguments of `l`
+/// \return      the hash of the expression starting at locus `l`
 ///
-/// Useful for individual comparison / information retrieval.
+/// Merkle-style hashing: the hash of a gene combines its opcode, its
+/// parameter (for parametric terminals) and the hashes of its arguments. A
+/// locus referenced many times (MEP individuals are DAGs) is processed just
+/// once.
 ///
-void i_mep::pack(const locus &l, std::vector<std::byte> *p) const
+hash_t i_mep::hash(const locus &l, const matrix<hash_t> &h) const
 {
   const gene &g(genome_(l));
 
-  // Although 16 bit are enough to contain opcodes and parameters, they are
-  // usually stored in unsigned variables (i.e. 32 or 64 bit) for performance
-  // reasons.
-  // Anyway before hashing opcodes/parameters we convert them to 16 bit types
-  // to avoid hashing more than necessary.
+  // Although 16 bit are enough to contain opcodes, they are usually stored in
+  // unsigned variables (i.e. 32 or 64 bit) for performance reasons.
+  // Anyway before hashing opcodes we convert them to 16 bit types to avoid
+  // hashing more than necessary.
   const auto opcode(static_cast<std::uint16_t>(g.sym->opcode()));
   assert(g.sym->opcode() <= std::numeric_limits<decltype(opcode)>::max());
 
-  auto s1 = reinterpret_cast<const std::byte *>(&opcode);
-  for (std::size_t i(0); i < sizeof(opcode); ++i)
-    p->push_back(s1[i]);
+  // The buffer is sized from the actual arity, which never exceeds
+  // `gene::k_args` (see `symbol_set::insert`): no heap allocation.
+  static_assert(sizeof(terminal_param_t) <= sizeof(hash_t::data));
+  const std::size_t slots(std::max<std::size_t>(g.sym->arity(), 1));
+  small_vector<std::byte,
+               sizeof(opcode) + gene::k_args * sizeof(hash_t::data)>
+    packed(sizeof(opcode) + slots * sizeof(hash_t::data));
+  std::size_t len(0);
 
-  auto arity(g.sym->arity());
-  if (arity)
-    for (const auto &al : g.arguments())
-      pack(al, p);
-  else
+  const auto append([&](const void *data, std::size_t n)
   {
-    if (terminal::cast(g.sym)->parametric())
-    {
-      const auto param(g.par);
+    std::memcpy(packed.data() + len, data, n);
+    len += n;
+  });
 
-      auto s2 = reinterpret_cast<const std::byte *>(&param);
-      for (std::size_t i(0); i < sizeof(param); ++i)
-        p->push_back(s2[i]);
-    }
+  append(&opcode, sizeof(opcode));
+
+  if (const auto arity = g.sym->arity())
+  {
+    for (unsigned i(0); i < arity; ++i)
+      append(h(g.locus_of_argument(i)).data, sizeof(hash_t::data));
+  }
+  else if (terminal::cast(g.sym)->parametric())
+  {
+    const auto param(g.par);
+    append(&param, sizeof(param));
   }
+
+  return vita::hash::hash128(packed.data(), len);
+}
+
+///
+/// Marks as stale the hashes depending on a stale hash.
+///
+/// \param[in] sup greatest index of a changed gene (hashes of the changed
+///                genes must be already cleared)
+///
+/// The gene at locus `l` may only reference loci with greater indices, so a
+/// single backward scan, starting just before `sup`, is enough to propagate
+/// the changes.
+///
+void i_mep::stale_hashes(index_t sup)
+{
+  const category_t c_sup(categories());
+
+  for (index_t i(sup); i-- > 0;)
+    for (category_t c(0); c < c_sup; ++c)
+    {
+      hash_t &h(hashes_(i, c));
+      if (h.empty())
+        continue;
+
+      const gene &g(genome_(i, c));
+      const auto arity(g.sym->arity());
+      for (unsigned j(0); j < arity; ++j)
+        if (hashes_(g.locus_of_argument(j)).empty())
+        {
+          h.clear();
+          break;
+        }
+    }
 }
 
 ///
-/// Converts this individual in a packed byte level representation and
-/// performs the hash algorithm on it.
+/// Hashes the active code of this individual.
 ///
 /// \return the signature of this individual
 ///
+/// Only the stale hashes of the active loci are computed: after a mutation
+/// these are the loci on the path from the changed genes to `best()`.
+///
 hash_t i_mep::hash() const
 {
   Expects(size());
-  // if (empty())
-  //   return hash_t();
-
-  // From an individual to a packed byte stream...
-  thread_local std::vector<std::byte> packed;
 
-  packed.clear();
-  pack(best(), &packed);
+  const auto &active(exons());
 
-  /// ... and from a packed byte stream to a signature...
-  const auto len(packed.size() * sizeof(packed[0]));  // length in bytes
+  // Arguments of a gene always have greater indices, so scanning active loci
+  // backwards every hash is computed after the hashes of its arguments.
+  std::for_each(active.rbegin(), active.rend(),
+                [this](const locus &l)
+                {
+                  if (hashes_(l).empty())
+                    hashes_(l) = hash(l, hashes_);
+                });
 
-  return vita::hash::hash128(packed.data(), len);
+  return hashes_(best());
 }
 
 ///
@@ -392,6 +537,23 @@ hash_t i_mep::signature() const
   return signature_;
 }
 
+///
+/// \param[in] l an active locus
+/// \return      the signature of the expression starting at `l`
+///
+/// Expressions with the same signature compute the same values, even when
+/// they belong to distinct individuals (e.g. the code an offspring inherits
+/// from a parent).
+///
+hash_t i_mep::signature(const locus &l) const
+{
+  if (hashes_(l).empty())
+    hash();
+
+  Ensures(!hashes_(l).empty());
+  return hashes_(l);
+}
+
 ///
 /// \return `true` if the individual passes the internal consistency check
 ///
@@ -432,7 +594,11 @@ bool i_mep::is_valid() const
       }
 
       // Correspondence between arity of the symbol and numbers of parameters.
+      // (`args` is meaningful only for functions).
       const auto arity(genome_(l).sym->arity());
+      if (!arity)
+        continue;
+
       if (genome_(l).args.size() != arity)
       {
         vitaERROR << "Arity and actual arguments don't match";
@@ -499,6 +665,46 @@ bool i_mep::is_valid() const
     return false;
   }
 
+  if (hashes_.rows() != size() || hashes_.cols() != categories())
+  {
+    vitaERROR << "Wrong size of the hash matrix";
+    return false;
+  }
+
+  for (index_t i(0); i < size(); ++i)
+    for (category_t c(0); c < categories(); ++c)
+    {
+      const locus l{i, c};
+      if (hashes_(l).empty())
+        continue;
+
+      const gene &g(genome_(l));
+      for (unsigned j(0); j < g.sym->arity(); ++j)
+        if (hashes_(g.locus_of_argument(j)).empty())
+        {
+          vitaERROR << "Stale argument of an up to date hash";
+          return false;
+        }
+
+      if (hashes_(l) != hash(l, hashes_))
+      {
+        vitaERROR << "Wrong hash at locus " << l;
+        return false;
+      }
+    }
+
+  if (!exons_.empty())
+  {
+    std::vector<locus> active;
+    scan_exons(active);
+
+    if (exons_ != active)
+    {
+      vitaERROR << "Wrong list of active loci";
+      return false;
+    }
+  }
+
   return signature_.empty() || signature_ == hash();
 }
 
@@ -541,7 +747,9 @@ bool i_mep::load_impl(std::istream &in, const symbol_set &ss)
     auto arity(temp.sym->arity());
     if (arity)
     {
-      temp.args.resize(arity);
+      // Assignment (unlike `resize`) makes `args` the active member of the
+      // union.
+      temp.args = gene::arg_pack(arity);
 
       for (auto &arg : temp.args)
         if (!(in >> arg))
@@ -558,6 +766,8 @@ bool i_mep::load_impl(std::istream &in, const symbol_set &ss)
 
   best_ = best;
   genome_ = genome;
+  exons_.clear();
+  hashes_ = matrix<hash_t>(rows, cols);
 
   return true;
 }
@@ -638,25 +848,31 @@ i_mep i_mep::cse() const
       const locus current_locus({i - 1, c});
       gene &g(ret.genome_(current_locus));
 
-      std::transform(
-        g.args.begin(), g.args.end(),
-        g.args.begin(),
-        [&, i=0u](auto arg) mutable -> gene::packed_index_t
-        {
-          const gene gene_arg(ret[g.locus_of_argument(i++)]);
-          const auto where(new_locus.find(gene_arg));
+      if (g.sym->arity())
+        std::transform(
+          g.args.begin(), g.args.end(),
+          g.args.begin(),
+          [&, i=0u](auto arg) mutable -> gene::packed_index_t
+          {
+            const gene gene_arg(ret[g.locus_of_argument(i++)]);
+            const auto where(new_locus.find(gene_arg));
 
-          if (where == new_locus.end())
-            return arg;
+            if (where == new_locus.end())
+              return arg;
 
-          assert(where->second.index <=
-                 std::numeric_limits<gene::packed_index_t>::max());
-          return where->second.index;
-        });
+            assert(where->second.index <=
+                   std::numeric_limits<gene::packed_index_t>::max());
+            return where->second.index;
+          });
 
       new_locus.try_emplace(g, current_locus);
     }
 
+  // Arguments may have changed (the hashes and so the signature haven't).
+  // The active loci are rebuilt here: an individual with a signature has
+  // its exons too (they're read concurrently, see `exons()`).
+  ret.scan_exons(ret.exons_);
+
   return ret;
 }
 
@@ -739,6 +955,19 @@ i_mep crossover(const i_mep &lhs, const i_mep &rhs)
   const i_mep &from(b ? rhs : lhs);
   i_mep          to(b ? lhs : rhs);
 
+  // Hashes of the changed loci are cleared. `changed_sup` is the greatest
+  // changed index.
+  index_t changed_sup(0);
+  const auto copy_gene([&](const locus &l)
+  {
+    if (to.genome_(l) != from[l])
+    {
+      to.genome_(l) = from[l];
+      to.hashes_(l).clear();
+      changed_sup = std::max(changed_sup, l.index);
+    }
+  });
+
   switch (from.active_crossover_type_)
   {
   case i_mep::crossover_t::one_point:
@@ -749,10 +978,7 @@ i_mep crossover(const i_mep &lhs, const i_mep &rhs)
 
     for (index_t i(cut); i < i_sup; ++i)
       for (category_t c(0); c < c_sup; ++c)
-      {
-        const locus l{i, c};
-        to.genome_(l) = from[l];
-      }
+        copy_gene({i, c});
     }
     break;
 
@@ -766,10 +992,7 @@ i_mep crossover(const i_mep &lhs, const i_mep &rhs)
 
     for (index_t i(cut1); i != cut2; ++i)
       for (category_t c(0); c < c_sup; ++c)
-      {
-        const locus l{i, c};
-        to.genome_(l) = from[l];
-      }
+        copy_gene({i, c});
     }
     break;
 
@@ -781,10 +1004,7 @@ i_mep crossover(const i_mep &lhs, const i_mep &rhs)
     for (index_t i(0); i != i_sup; ++i)
       for (category_t c(0); c < c_sup; ++c)
         if (random::boolean())
-        {
-          const locus l{i, c};
-          to.genome_(l) = from[l];
-        }
+          copy_gene({i, c});
     }
     break;
 
@@ -792,7 +1012,7 @@ i_mep crossover(const i_mep &lhs, const i_mep &rhs)
     {
       auto crossover_ = [&](locus l, const auto &lambda) -> void
       {
-        to.genome_(l) = from[l];
+        copy_gene(l);
 
         for (const auto &al : from[l].arguments())
           lambda(al, lambda);
@@ -803,6 +1023,9 @@ i_mep crossover(const i_mep &lhs, const i_mep &rhs)
     break;
   }
 
+  to.stale_hashes(changed_sup);
+  to.exons_.clear();
+
   to.active_crossover_type_ = from.active_crossover_type_;
   to.set_older_age(from.age());
   to.signature_.clear();
@@ -811,17 +1034,13 @@ i_mep crossover(const i_mep &lhs, const i_mep &rhs)
   return to;
 }
 
+///
+/// \param[in] prg a program
+/// \return        a random active locus of `prg`
+///
 locus random_locus(const i_mep &prg)
 {
-  std::set exons({prg.best()});
-  auto iter(exons.begin());
-  do
-  {
-    const auto args(prg[*iter].arguments());
-    exons.insert(args.begin(), args.end());
-  } while (++iter != exons.end());
-
-  return random::element(std::as_const(exons));
+  return random::element(prg.exons());
 }
 
 namespace
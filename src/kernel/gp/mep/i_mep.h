@@ -33,8 +33,8 @@ namespace vita
 class i_mep : public individual<i_mep>
 {
 public:
-  i_mep() : individual(), genome_(), best_(locus::npos()),
-            active_crossover_type_() {}
+  i_mep() : individual(), genome_(), hashes_(), exons_(),
+            best_(locus::npos()), active_crossover_type_() {}
 
   explicit i_mep(const problem &);
   explicit i_mep(const std::vector<gene> &);
@@ -58,10 +58,12 @@ public:
   bool operator==(const i_mep &) const;
 
   hash_t signature() const;
+  hash_t signature(const locus &) const;
 
   const gene &operator[](locus) const;
 
   unsigned active_symbols() const;
+  const std::vector<locus> &exons() const;
   category_t categories() const;
   bool empty() const;
   unsigned size() const;
@@ -89,7 +91,9 @@ public:
 private:
   // ---- Private support methods ----
   hash_t hash() const;
-  void pack(const locus &, std::vector<std::byte> *) const;
+  hash_t hash(const locus &, const matrix<hash_t> &) const;
+  void stale_hashes(index_t);
+  void scan_exons(std::vector<locus> &) const;
 
   // Serialization.
   bool load_impl(std::istream &, const symbol_set &);
@@ -101,6 +105,16 @@ private:
   // organism's hereditary information).
   matrix<gene> genome_;
 
+  // Hashes of the expressions starting at every locus (see `hash()`). An
+  // empty hash must be (re)computed. A non-empty hash is always up to date:
+  // when a gene changes, its hash and the hashes of the loci depending on it
+  // are cleared (see `stale_hashes()`).
+  mutable matrix<hash_t> hashes_;
+
+  // Active loci in ascending order (see `exons()`). An empty vector must be
+  // (re)computed: it's cleared whenever the genome or the best locus change.
+  mutable std::vector<locus> exons_;
+
   // Starting point of the active code in this individual (the best sequence
   // of genes starts here).
   locus best_;
@@ -20,6 +20,14 @@
 ///
 /// Iterator to scan the active genes of an individual.
 ///
+/// Active loci are visited in ascending order, reading the list cached by the
+/// individual (see `i_mep::exons()`).
+///
+/// \warning
+/// The list isn't updated while iterating: changing a gene via the iterator
+/// doesn't change the loci visited (the individual must invalidate the list
+/// afterwards).
+///
 template<bool is_const>
 class i_mep::basic_iterator
 {
@@ -39,31 +47,19 @@ public:
   /// Builds an empty iterator.
   ///
   /// Empty iterator is used as sentry (it's the value returned by end()).
-  basic_iterator() : loci_(), ind_(nullptr) {}
+  basic_iterator() : cur_(nullptr), end_(nullptr), ind_(nullptr) {}
 
   /// \param[in] id an individual
-  explicit basic_iterator(ind &id) : loci_({id.best()}), ind_(&id)
+  explicit basic_iterator(ind &id)
+    : cur_(id.exons().data()), end_(cur_ + id.exons().size()), ind_(&id)
   {
   }
 
   /// \return iterator representing the next active gene
   basic_iterator &operator++()
   {
-    if (!loci_.empty())
-    {
-      const auto args(operator*().arguments());
-
-      if (args.empty())
-        loci_.erase(loci_.begin());
-      else
-      {
-        auto node(loci_.extract(loci_.begin()));
-        node.value() = args.front();
-        loci_.insert(std::move(node));
-
-        loci_.insert(std::next(args.begin()), args.end());
-      }
-    }
+    if (cur_ != end_)
+      ++cur_;
 
     return *this;
   }
@@ -75,8 +71,7 @@ public:
   {
     Ensures(!ind_ || !rhs.ind_ || ind_ == rhs.ind_);
 
-    return (loci_.empty() && rhs.loci_.empty()) ||
-           loci_.cbegin() == rhs.loci_.cbegin();
+    return (cur_ == end_ && rhs.cur_ == rhs.end_) || cur_ == rhs.cur_;
   }
 
   bool operator!=(const basic_iterator &rhs) const
@@ -99,14 +94,13 @@ public:
   /// \return the locus of the current gene
   vita::locus locus() const
   {
-    return *loci_.cbegin();
+    assert(cur_ != end_);
+    return *cur_;
   }
 
 private:
-  // A partial set of active loci to be explored.
-  // We have tried with `std::vector<bool>` and `std::vector<uint8_t>` based
-  // iterators without measuring significant speed differences.
-  std::set<vita::locus> loci_;
+  // Current position in / end of the list of active loci.
+  const vita::locus *cur_, *end_;
 
   // A pointer to the individual we are iterating on.
   ind *ind_;
@@ -0,0 +1,169 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2024 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#include <algorithm>
+#include <map>
+
+#include "kernel/gp/src/batch_interpreter.h"
+
+namespace vita
+{
+
+///
+/// \param[in] prg   the program to be executed
+/// \param[in] cache outputs of expressions shared with other programs (can be
+///                  `nullptr`)
+///
+/// Active loci are collected and sorted in evaluation order: the arguments of
+/// a gene have greater indices than the gene itself, so descending loci are
+/// a topological order.
+///
+/// \warning
+/// The lifetime of `prg` (and of `cache`) must extend beyond that of the
+/// interpreter.
+///
+batch_interpreter::batch_interpreter(const i_mep *prg, column_cache *cache)
+  : prg_(prg), code_(), columns_(), real_(true), val_(), ok_(), args_(),
+    cache_(cache), source_()
+{
+  Expects(prg);
+
+  std::vector<locus> active;
+  for (auto i(prg->begin()); i != prg->end(); ++i)
+    active.push_back(i.locus());
+
+  // `i_mep::const_iterator` scans loci in ascending order.
+  std::reverse(active.begin(), active.end());
+
+  std::map<locus, std::size_t> position;
+  code_.reserve(active.size());
+  std::size_t max_args(0);
+  for (const auto &l : active)
+  {
+    const gene &g((*prg)[l]);
+
+    const auto *kernel(dynamic_cast<const real::vector_kernel *>(g.sym));
+    if (!kernel && !g.sym->terminal())
+      real_ = false;
+
+    instruction ins{&g, dynamic_cast<const variable *>(g.sym), kernel, {},
+                    cache ? prg->signature(l) : hash_t()};
+    ins.args.reserve(g.sym->arity());
+    max_args = std::max<std::size_t>(max_args, g.sym->arity());
+    for (unsigned i(0); i < g.sym->arity(); ++i)
+      ins.args.push_back(position.at(g.locus_of_argument(i)));
+
+    position[l] = code_.size();
+    code_.push_back(std::move(ins));
+  }
+
+  columns_.resize(code_.size() * block_size);
+
+  if (real_)
+  {
+    val_.resize(code_.size() * block_size);
+    ok_.resize(code_.size() * block_size);
+    args_.resize(max_args);
+
+    if (cache_)
+      source_.resize(code_.size());
+  }
+
+  Ensures(!code_.empty());
+  Ensures(code_.back().g == &(*prg)[prg->best()]);
+}
+
+///
+/// Computes the output of the program for a block of rows of a columnar
+/// dataframe.
+///
+/// \param[in] d     a columnar dataframe
+/// \param[in] first index of the first row of the block
+/// \param[in] n     number of rows (at most `block_size`)
+/// \param[in] step  distance between two consecutive rows of the block
+///
+/// The output value for the `first + i * step`-th example is then available
+/// via `operator[](i)`.
+///
+void batch_interpreter::run(const dataframe::columnar &d, std::size_t first,
+                            std::size_t n, std::size_t step)
+{
+  Expects(n <= block_size);
+  Expects(step);
+  Expects(!n || first + (n - 1) * step < d.size());
+
+  // Identifies the block in the column cache. The version, unlike the
+  // address of `d`, is never shared by snapshots with different content.
+  hash_t block;
+  if (cache_)
+  {
+    const std::uint64_t id[4] = {d.version(), first, n, step};
+    block = hash::hash128(id, sizeof(id));
+  }
+
+  run_block(n,
+            [&](const instruction &ins, std::size_t r)
+            {
+              return column_params(*this, ins, r, d, first + r * step);
+            },
+            block, &d, first, step);
+}
+
+///
+/// Decides how every column of the current block is obtained.
+///
+/// \param[in] rows  number of examples of the block
+/// \param[in] block identifier of the block
+///
+/// Starting from the output, the columns of the functions are looked up in
+/// the cache (and copied when available). The arguments of a column found in
+/// the cache aren't required unless other columns use them.
+///
+void batch_interpreter::plan(std::size_t rows, const hash_t &block)
+{
+  Expects(cache_);
+  Expects(source_.size() == code_.size());
+
+  std::fill(source_.begin(), source_.end(), source::unused);
+  source_.back() = source::compute;
+
+  // Arguments precede the instructions using them.
+  for (std::size_t c(code_.size()); c--;)
+  {
+    if (source_[c] != source::compute)
+      continue;
+
+    const auto &ins(code_[c]);
+    if (ins.kernel
+        && cache_->find(column_cache::key(ins.signature, block),
+                        {&val_[c * block_size], &ok_[c * block_size]}, rows))
+    {
+      source_[c] = source::cache;
+      continue;
+    }
+
+    for (const auto a : ins.args)
+      source_[a] = source::compute;
+  }
+}
+
+///
+/// \param[in] i index of an example of the last block processed
+/// \return      the output value of the program for the `i`-th example
+///
+const value_t &batch_interpreter::operator[](std::size_t i) const
+{
+  Expects(i < block_size);
+  return columns_[(code_.size() - 1) * block_size + i];
+}
+
+}  // namespace vita
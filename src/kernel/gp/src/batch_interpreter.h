@@ -0,0 +1,127 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2024 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#if !defined(VITA_SRC_BATCH_INTERPRETER_H)
+#define      VITA_SRC_BATCH_INTERPRETER_H
+
+#include "kernel/core_interpreter.h"
+#include "kernel/gp/mep/i_mep.h"
+#include "kernel/gp/src/column_cache.h"
+#include "kernel/gp/src/primitive/real_kernel.h"
+#include "kernel/gp/src/variable.h"
+
+namespace vita
+{
+
+///
+/// Executes an i_mep individual over a block of examples.
+///
+/// The scalar interpreter walks the active code once per example (resetting
+/// its cache every time). Here the active loci are ordered (arguments before
+/// the genes using them) just once and every locus is computed as a column of
+/// values over the whole block of examples.
+///
+/// Results are identical to those of vita::src_interpreter: like the scalar
+/// interpreter, we assume referential transparency for all the expressions.
+///
+/// When every active function provides a vectorised kernel (see
+/// real::vector_kernel) columns are plain arrays of doubles with a validity
+/// mask and there isn't any per-example virtual call or `value_t` conversion.
+/// With a columnar dataframe (see dataframe::columnar) real-valued features
+/// are copied straight from their columns.
+///
+/// On the real-valued path the outputs of the active functions can be shared
+/// via a vita::column_cache: expressions whose output is available for the
+/// current block of examples aren't computed (neither are the expressions used
+/// only by them).
+///
+/// \remark
+/// Every active locus is computed, even the ones a lazy (scalar) evaluation
+/// would skip (e.g. the branch not taken by an *if* function).
+///
+class batch_interpreter
+{
+public:
+  /// Maximum number of examples processed at the same time.
+  static constexpr std::size_t block_size = 256;
+
+  explicit batch_interpreter(const i_mep *, column_cache * = nullptr);
+
+  template<class E> void run(const std::vector<E *> &, std::uint64_t = 0);
+  void run(const dataframe::columnar &, std::size_t, std::size_t,
+           std::size_t = 1);
+
+  [[nodiscard]] const value_t &operator[](std::size_t) const;
+
+  [[nodiscard]] const i_mep &program() const { return *prg_; }
+
+private:
+  class column_params;
+
+  template<class P> void run_block(std::size_t, P, const hash_t &,
+                                    const dataframe::columnar * = nullptr,
+                                    std::size_t = 0, std::size_t = 1);
+  template<class P> void run_generic(std::size_t, P);
+  template<class P> [[nodiscard]] bool run_real(std::size_t, P, const hash_t &,
+                                                const dataframe::columnar *,
+                                                std::size_t, std::size_t);
+  void plan(std::size_t, const hash_t &);
+
+  struct instruction
+  {
+    const gene *g;
+
+    // `g->sym` if it's a variable, `nullptr` otherwise.
+    const variable *var;
+
+    // Vectorised version of `g->sym` (`nullptr` for terminals and for
+    // functions without a kernel).
+    const real::vector_kernel *kernel;
+
+    // Index (in the sequence of instructions) of the arguments of `g`.
+    std::vector<std::size_t> args;
+
+    // Signature of the expression starting at `g` (only used with a column
+    // cache).
+    hash_t signature;
+  };
+
+  // How a column is obtained when a column cache is available.
+  enum class source : std::uint8_t {compute, cache, unused};
+
+  // *** Private data members ***
+  const i_mep *prg_;
+
+  // Active code in evaluation order (the last instruction is the output).
+  std::vector<instruction> code_;
+
+  // Column-major matrix: `block_size` values for every instruction.
+  std::vector<value_t> columns_;
+
+  // Real-valued version of `columns_` (values and validity masks). Used only
+  // when every active function has a vectorised kernel.
+  bool real_;
+  std::vector<D_DOUBLE> val_;
+  std::vector<real::mask_t> ok_;
+  std::vector<real::const_column> args_;
+
+  // Shared outputs of the functions (can be `nullptr`) and source of every
+  // column for the current block.
+  column_cache *cache_;
+  std::vector<source> source_;
+};
+
+#include "kernel/gp/src/batch_interpreter.tcc"
+
+}  // namespace vita
+
+#endif  // include guard
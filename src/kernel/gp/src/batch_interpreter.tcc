@@ -0,0 +1,255 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2024 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#if !defined(VITA_SRC_BATCH_INTERPRETER_H)
+#  error "Don't include this file directly, include the specific .h instead"
+#endif
+
+#if !defined(VITA_SRC_BATCH_INTERPRETER_TCC)
+#define      VITA_SRC_BATCH_INTERPRETER_TCC
+
+///
+/// Parameters passed to a symbol when computing a single cell of a column.
+///
+/// Arguments are already available (they're in the columns of previous
+/// instructions) so there isn't any recursive evaluation.
+///
+class batch_interpreter::column_params : public symbol_params
+{
+public:
+  column_params(const batch_interpreter &bi, const instruction &ins,
+                std::size_t row, const std::vector<value_t> &input)
+    : bi_(bi), ins_(ins), row_(row), input_(&input), data_(nullptr),
+      data_row_(0)
+  {
+  }
+
+  column_params(const batch_interpreter &bi, const instruction &ins,
+                std::size_t row, const dataframe::columnar &data,
+                std::size_t data_row)
+    : bi_(bi), ins_(ins), row_(row), input_(nullptr), data_(&data),
+      data_row_(data_row)
+  {
+  }
+
+  [[nodiscard]] value_t fetch_arg(unsigned i) final
+  {
+    Expects(i < ins_.args.size());
+    return bi_.columns_[ins_.args[i] * block_size + row_];
+  }
+
+  value_t fetch_opaque_arg(unsigned i) final { return fetch_arg(i); }
+
+  [[nodiscard]] terminal_param_t fetch_param() const final
+  {
+    return ins_.g->par;
+  }
+
+  [[nodiscard]] value_t fetch_var(unsigned i) final
+  {
+    if (data_)
+    {
+      Expects(i < data_->variables());
+      return data_->input(i)[data_row_];
+    }
+
+    Expects(i < input_->size());
+    return (*input_)[i];
+  }
+
+private:
+  const batch_interpreter &bi_;
+  const instruction &ins_;
+  const std::size_t row_;
+
+  // Exactly one of `input_` / `data_` is used.
+  const std::vector<value_t> *input_;
+  const dataframe::columnar *data_;
+  const std::size_t data_row_;
+};
+
+///
+/// Computes the output of the program for a block of examples.
+///
+/// \param[in] block   pointers to (at most `block_size`) examples
+/// \param[in] version version of the dataset containing the examples (see
+///                    `dataframe::version()`). Required when a column cache
+///                    is used
+///
+/// The output value for the `i`-th example is then available via
+/// `operator[](i)`.
+///
+/// \remark
+/// The addresses of the examples identify them only for a given version of
+/// the dataset: a reallocated dataset (or a new one at the same address)
+/// mustn't get the cached columns of the previous one.
+///
+template<class E>
+void batch_interpreter::run(const std::vector<E *> &block,
+                            std::uint64_t version)
+{
+  Expects(block.size() <= block_size);
+  Expects(!cache_ || version);
+
+  // Identifies the block (i.e. the sequence of examples of a given version
+  // of the dataset) in the column cache.
+  hash_t id;
+  if (cache_)
+  {
+    id = hash::hash128(block.data(), block.size() * sizeof(E *));
+
+    const std::uint64_t key[3] = {id.data[0], id.data[1], version};
+    id = hash::hash128(key, sizeof(key));
+  }
+
+  run_block(block.size(),
+            [&](const instruction &ins, std::size_t r)
+            {
+              return column_params(*this, ins, r, block[r]->input);
+            },
+            id);
+}
+
+///
+/// \param[in] rows   number of examples of the block
+/// \param[in] params builds the parameters used to evaluate an instruction
+///                   for a given example of the block
+/// \param[in] block  identifier of the block in the column cache
+/// \param[in] data   the columnar dataframe containing the block (if any)
+/// \param[in] first  index (in `data`) of the first example of the block
+/// \param[in] step   distance (in `data`) between consecutive examples
+///
+template<class P>
+void batch_interpreter::run_block(std::size_t rows, P params,
+                                  const hash_t &block,
+                                  const dataframe::columnar *data,
+                                  std::size_t first, std::size_t step)
+{
+  if (real_)
+  {
+    if (run_real(rows, params, block, data, first, step))
+      return;
+
+    // Some terminal isn't real-valued: the real path cannot be used for this
+    // program.
+    real_ = false;
+  }
+
+  run_generic(rows, params);
+}
+
+template<class P>
+void batch_interpreter::run_generic(std::size_t rows, P params)
+{
+  for (std::size_t c(0); c < code_.size(); ++c)
+  {
+    const auto &ins(code_[c]);
+    auto *column(&columns_[c * block_size]);
+
+    for (std::size_t r(0); r < rows; ++r)
+    {
+      auto p(params(ins, r));
+      column[r] = ins.g->sym->eval(p);
+    }
+  }
+}
+
+///
+/// Computes the output of the program using the vectorised kernels.
+///
+/// \param[in] rows   number of examples of the block
+/// \param[in] params builds the parameters used to evaluate an instruction
+///                   for a given example of the block
+/// \param[in] block  identifier of the block in the column cache
+/// \param[in] data   the columnar dataframe containing the block (if any)
+/// \param[in] first  index (in `data`) of the first example of the block
+/// \param[in] step   distance (in `data`) between consecutive examples
+/// \return           `false` if a terminal produces a value which isn't a
+///                   real number (the generic path must be used)
+///
+template<class P>
+bool batch_interpreter::run_real(std::size_t rows, P params,
+                                 const hash_t &block,
+                                 const dataframe::columnar *data,
+                                 std::size_t first, std::size_t step)
+{
+  if (cache_)
+    plan(rows, block);
+
+  for (std::size_t c(0); c < code_.size(); ++c)
+  {
+    if (cache_ && source_[c] != source::compute)
+      continue;
+
+    const auto &ins(code_[c]);
+    const real::column out{&val_[c * block_size], &ok_[c * block_size]};
+
+    if (ins.kernel)
+    {
+      for (std::size_t i(0); i < ins.args.size(); ++i)
+      {
+        const auto a(ins.args[i] * block_size);
+        args_[i] = {&val_[a], &ok_[a]};
+      }
+
+      ins.kernel->eval_columns(args_.data(), out, rows);
+
+      if (cache_)
+        cache_->insert(column_cache::key(ins.signature, block),
+                       {out.val, out.ok}, rows);
+    }
+    else if (data && ins.var
+             && data->input(ins.var->var_id()).domain == d_double)
+    {
+      // Real-valued feature of a columnar dataframe: a plain copy.
+      const auto *src(data->input(ins.var->var_id()).real.data() + first);
+
+      if (step == 1)
+        std::copy(src, src + rows, out.val);
+      else
+        for (std::size_t r(0); r < rows; ++r)
+          out.val[r] = src[r * step];
+
+      std::fill(out.ok, out.ok + rows, true);
+    }
+    else  // terminal
+      for (std::size_t r(0); r < rows; ++r)
+      {
+        auto p(params(ins, r));
+        const value_t v(ins.g->sym->eval(p));
+
+        if (const auto *d = std::get_if<D_DOUBLE>(&v))
+        {
+          out.val[r] = *d;
+          out.ok[r] = true;
+        }
+        else if (!has_value(v))
+        {
+          out.val[r] = 0.0;
+          out.ok[r] = false;
+        }
+        else
+          return false;
+      }
+  }
+
+  const auto last((code_.size() - 1) * block_size);
+  for (std::size_t r(0); r < rows; ++r)
+    if (ok_[last + r])
+      columns_[last + r] = val_[last + r];
+    else
+      columns_[last + r] = {};
+
+  return true;
+}
+
+#endif  // include guard
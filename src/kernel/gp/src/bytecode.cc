@@ -0,0 +1,154 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2024 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#include <algorithm>
+
+#include "kernel/gp/src/bytecode.h"
+#include "kernel/gp/src/variable.h"
+
+namespace vita
+{
+
+///
+/// Compiles the active code of a program.
+///
+/// \param[in] prg the program to be compiled
+///
+/// The arguments of a gene have greater indices than the gene itself, so
+/// descending loci are a topological order.
+///
+bytecode::bytecode(const i_mep &prg)
+  : code_(), operands_(), real_(true), max_args_(0)
+{
+  std::vector<locus> active;
+  for (auto i(prg.begin()); i != prg.end(); ++i)
+    active.push_back(i.locus());
+
+  // `i_mep::const_iterator` scans loci in ascending order.
+  std::reverse(active.begin(), active.end());
+
+  // Register assigned to every active locus.
+  matrix<std::uint32_t> reg(prg.size(), prg.categories());
+
+  code_.reserve(active.size());
+  for (const auto &l : active)
+  {
+    const gene &g(prg[l]);
+
+    instruction ins{opcode::eval, 0,
+                    static_cast<std::uint32_t>(operands_.size()), &g,
+                    dynamic_cast<const real::vector_kernel *>(g.sym), 0.0};
+
+    if (const auto *v = dynamic_cast<const variable *>(g.sym))
+    {
+      ins.op = opcode::variable;
+      ins.imm = v->var_id();
+    }
+    else if (g.sym->terminal())
+    {
+      // Constants are evaluated once. Other input terminals (only
+      // `variable`s are directly supported) prevent the execution on plain
+      // doubles.
+      ins.kernel = nullptr;
+
+      if (g.sym->input())
+        real_ = false;
+      else
+      {
+        const auto no_var([](unsigned) { return value_t(); });
+        const std::vector<value_t> none;
+        params<decltype(no_var)> p(*this, ins, none, no_var);
+
+        const value_t val(g.sym->eval(p));
+        const auto *d(std::get_if<D_DOUBLE>(&val));
+
+        if (d && std::isfinite(*d))
+          ins.constant = *d;
+        else
+          real_ = false;
+      }
+    }
+    else if (!ins.kernel)
+      real_ = false;
+
+    max_args_ = std::max(max_args_, g.sym->arity());
+
+    for (unsigned i(0); i < g.sym->arity(); ++i)
+      operands_.push_back(reg(g.locus_of_argument(i)));
+
+    reg(l) = static_cast<std::uint32_t>(code_.size());
+    code_.push_back(ins);
+  }
+
+  Ensures(!code_.empty());
+  Ensures(code_.back().g == &prg[prg.best()]);
+}
+
+///
+/// Calculates the output of the program given a specific input.
+///
+/// \param[in] reg registers (resized when required)
+/// \param[in] ex  a vector of values for the problem's variables
+/// \return        the output value of the program
+///
+value_t bytecode::run(registers &reg, const std::vector<value_t> &ex) const
+{
+  const auto var([&ex](unsigned i)
+                 {
+                   Expects(i < ex.size());
+                   return ex[i];
+                 });
+
+  return real_ ? exec_real(reg, var) : exec(reg, var);
+}
+
+///
+/// Calculates the output of the program given a specific example of a
+/// columnar dataframe.
+///
+/// \param[in] reg registers (resized when required)
+/// \param[in] d   a columnar dataframe
+/// \param[in] row index of the example
+/// \return        the output value of the program
+///
+value_t bytecode::run(registers &reg, const dataframe::columnar &d,
+                      std::size_t row) const
+{
+  Expects(row < d.size());
+
+  const auto var([&d, row](unsigned i)
+                 {
+                   Expects(i < d.variables());
+                   return d.input(i)[row];
+                 });
+
+  return real_ ? exec_real(reg, var) : exec(reg, var);
+}
+
+///
+/// \return number of instructions (i.e. of active loci)
+///
+std::size_t bytecode::size() const
+{
+  return code_.size();
+}
+
+///
+/// \return `true` if the program is executed on plain doubles (see the class
+///         description)
+///
+bool bytecode::real() const
+{
+  return real_;
+}
+
+}  // namespace vita
@@ -0,0 +1,260 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2024 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#if !defined(VITA_SRC_BYTECODE_H)
+#define      VITA_SRC_BYTECODE_H
+
+#include <cmath>
+#include <cstdint>
+
+#include "kernel/core_interpreter.h"
+#include "kernel/gp/mep/i_mep.h"
+#include "kernel/gp/src/dataframe.h"
+#include "kernel/gp/src/primitive/real_kernel.h"
+
+namespace vita
+{
+
+///
+/// The active code of an i_mep individual compiled to a flat register
+/// machine.
+///
+/// The tree-walking interpreter (vita::interpreter<i_mep>) follows the
+/// arguments of every gene recursively and memoizes the intermediate values.
+/// Here the active loci are sorted once (arguments before the genes using
+/// them) and every locus becomes an instruction writing its own register: the
+/// `i`-th instruction writes the `i`-th register and reads the registers of
+/// its arguments. Executing a program is a single forward scan without
+/// recursion, locus lookups or cache checks.
+///
+/// The object doesn't change after construction and can be shared among many
+/// interpreters of the same program (registers are supplied by the caller).
+///
+/// When every active function is a real-valued primitive (see
+/// real::vector_kernel) and every terminal is a variable or a real constant,
+/// the program is also executed on plain doubles: NaN stands for the empty
+/// value and there isn't any `value_t` construction / copy / conversion
+/// (except for reading the input variables). Examples containing values which
+/// aren't finite real numbers are processed the usual way.
+///
+/// \remark
+/// Every active locus is computed, even the ones a lazy evaluation would skip
+/// (e.g. the branch not taken by an *if* function). Like the tree-walking
+/// interpreter we assume referential transparency, so the results are the
+/// same.
+///
+/// \warning
+/// The lifetime of the program must extend beyond that of the bytecode and
+/// the program mustn't change.
+///
+class bytecode
+{
+public:
+  /// Working memory for the execution of a program.
+  struct registers
+  {
+    std::vector<value_t> val = {};
+
+    // Used for the execution on plain doubles.
+    std::vector<D_DOUBLE> real = {};
+    std::vector<D_DOUBLE> args = {};
+  };
+
+  explicit bytecode(const i_mep &);
+
+  value_t run(registers &, const std::vector<value_t> &) const;
+  value_t run(registers &, const dataframe::columnar &, std::size_t) const;
+
+  [[nodiscard]] std::size_t size() const;
+  [[nodiscard]] bool real() const;
+
+private:
+  // - `variable` copies an input variable;
+  // - `eval` calls the `eval` function of the symbol.
+  enum class opcode : std::uint8_t {variable, eval};
+
+  struct instruction
+  {
+    opcode op;
+
+    // Index of the input variable (`opcode::variable`).
+    unsigned imm;
+
+    // Position of the first source register in `operands_` (the number of
+    // source registers is the arity of the symbol).
+    std::uint32_t src;
+
+    // The symbol and its parameter.
+    const gene *g;
+
+    // Execution on plain doubles (`opcode::eval`): the scalar kernel of a
+    // function or the value of a constant.
+    const real::vector_kernel *kernel;
+    D_DOUBLE constant;
+  };
+
+  template<class F> class params;
+
+  template<class F> value_t exec(registers &, F) const;
+  template<class F> value_t exec_real(registers &, F) const;
+
+  // Active code in evaluation order (the last instruction is the output).
+  std::vector<instruction> code_;
+
+  // Source registers of every instruction, contiguously.
+  std::vector<std::uint32_t> operands_;
+
+  // `true` if the program can be executed on plain doubles.
+  bool real_;
+
+  // Maximum arity of the active functions.
+  unsigned max_args_;
+};
+
+///
+/// Parameters passed to a symbol: arguments are read from the registers
+/// (already computed) and variables via a user-supplied function.
+///
+template<class F>
+class bytecode::params : public symbol_params
+{
+public:
+  params(const bytecode &bc, const instruction &ins,
+         const std::vector<value_t> &reg, const F &var)
+    : bc_(bc), ins_(ins), reg_(reg), var_(var)
+  {
+  }
+
+  [[nodiscard]] value_t fetch_arg(unsigned i) final
+  {
+    Expects(i < ins_.g->sym->arity());
+    return reg_[bc_.operands_[ins_.src + i]];
+  }
+
+  value_t fetch_opaque_arg(unsigned i) final { return fetch_arg(i); }
+
+  [[nodiscard]] terminal_param_t fetch_param() const final
+  {
+    return ins_.g->par;
+  }
+
+  [[nodiscard]] value_t fetch_var(unsigned i) final { return var_(i); }
+
+private:
+  const bytecode &bc_;
+  const instruction &ins_;
+  const std::vector<value_t> &reg_;
+  const F &var_;
+};
+
+///
+/// The dispatch loop.
+///
+/// \param[in] reg registers (resized when required)
+/// \param[in] var a function returning the value of an input variable given
+///                its index
+/// \return        the output value of the program
+///
+template<class F>
+value_t bytecode::exec(registers &reg, F var) const
+{
+  auto &val(reg.val);
+  if (val.size() < code_.size())
+    val.resize(code_.size());
+
+  const auto n(code_.size());
+  for (std::size_t i(0); i < n; ++i)
+  {
+    const auto &ins(code_[i]);
+
+    switch (ins.op)
+    {
+    case opcode::variable:
+      val[i] = var(ins.imm);
+      break;
+
+    case opcode::eval:
+    {
+      params<F> p(*this, ins, val, var);
+      val[i] = ins.g->sym->eval(p);
+      break;
+    }
+    }
+  }
+
+  return val[n - 1];
+}
+
+///
+/// The dispatch loop for the execution on plain doubles.
+///
+/// \param[in] reg registers (resized when required)
+/// \param[in] var a function returning the value of an input variable given
+///                its index
+/// \return        the output value of the program
+///
+/// Falls back to `exec` when an input variable doesn't contain a finite real
+/// number (NaN couldn't be distinguished from the empty value).
+///
+template<class F>
+value_t bytecode::exec_real(registers &reg, F var) const
+{
+  Expects(real_);
+
+  auto &val(reg.real);
+  if (val.size() < code_.size())
+    val.resize(code_.size());
+  if (reg.args.size() < max_args_)
+    reg.args.resize(max_args_);
+
+  const auto n(code_.size());
+  for (std::size_t i(0); i < n; ++i)
+  {
+    const auto &ins(code_[i]);
+
+    switch (ins.op)
+    {
+    case opcode::variable:
+    {
+      const value_t v(var(ins.imm));
+      const auto *d(std::get_if<D_DOUBLE>(&v));
+
+      if (!d || !std::isfinite(*d))
+        return exec(reg, var);
+
+      val[i] = *d;
+      break;
+    }
+
+    case opcode::eval:
+      if (ins.kernel)
+      {
+        const auto arity(ins.g->sym->arity());
+        for (unsigned a(0); a < arity; ++a)
+          reg.args[a] = val[operands_[ins.src + a]];
+
+        val[i] = ins.kernel->eval_scalar(reg.args.data());
+      }
+      else
+        val[i] = ins.constant;
+      break;
+    }
+  }
+
+  if (std::isnan(val[n - 1]))
+    return {};
+  return val[n - 1];
+}
+
+}  // namespace vita
+
+#endif  // include guard
@@ -0,0 +1,166 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2024 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#include <algorithm>
+
+#include "kernel/gp/src/column_cache.h"
+
+namespace vita
+{
+
+///
+/// \param[in] n maximum number of columns stored (`0` disables the cache)
+///
+column_cache::column_cache(std::size_t n)
+  : mutex_(), lru_(), index_(), capacity_(n), hits_(0), misses_(0),
+    evictions_(0)
+{
+}
+
+///
+/// Sets the maximum number of columns stored.
+///
+/// \param[in] n maximum number of columns (`0` disables the cache)
+///
+/// Exceeding columns are discarded (least recently used first).
+///
+void column_cache::capacity(std::size_t n)
+{
+  std::lock_guard lock(mutex_);
+
+  capacity_ = n;
+  shrink();
+}
+
+///
+/// \return the maximum number of columns stored
+///
+std::size_t column_cache::capacity() const
+{
+  std::lock_guard lock(mutex_);
+  return capacity_;
+}
+
+///
+/// \return the number of columns stored
+///
+std::size_t column_cache::size() const
+{
+  std::lock_guard lock(mutex_);
+  return lru_.size();
+}
+
+///
+/// Discards every column (statistics are preserved).
+///
+void column_cache::clear()
+{
+  std::lock_guard lock(mutex_);
+
+  lru_.clear();
+  index_.clear();
+}
+
+///
+/// \param[in] expr  signature of an expression
+/// \param[in] block identifier of a block of examples
+/// \return          the key of the outputs of `expr` over `block`
+///
+hash_t column_cache::key(const hash_t &expr, const hash_t &block)
+{
+  const hash_t packed[2] = {expr, block};
+  return hash::hash128(packed, sizeof(packed));
+}
+
+///
+/// \param[in]  k    key of a column (see `key()`)
+/// \param[out] out  destination of the cached values
+/// \param[in]  rows length of the column
+/// \return          `true` if the column is available (and copied in `out`)
+///
+bool column_cache::find(const hash_t &k, real::column out, std::size_t rows)
+{
+  std::lock_guard lock(mutex_);
+
+  const auto it(index_.find(k));
+  if (it == index_.end() || it->second->val.size() != rows)
+  {
+    ++misses_;
+    return false;
+  }
+
+  lru_.splice(lru_.begin(), lru_, it->second);
+
+  std::copy(it->second->val.begin(), it->second->val.end(), out.val);
+  std::copy(it->second->ok.begin(), it->second->ok.end(), out.ok);
+
+  ++hits_;
+  return true;
+}
+
+///
+/// \param[in] k    key of a column (see `key()`)
+/// \param[in] in   values of the column
+/// \param[in] rows length of the column
+///
+void column_cache::insert(const hash_t &k, real::const_column in,
+                          std::size_t rows)
+{
+  std::lock_guard lock(mutex_);
+
+  if (!capacity_)
+    return;
+
+  if (const auto it = index_.find(k); it != index_.end())
+  {
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return;
+  }
+
+  lru_.push_front({k, std::vector<D_DOUBLE>(in.val, in.val + rows),
+                   std::vector<real::mask_t>(in.ok, in.ok + rows)});
+  index_[k] = lru_.begin();
+
+  shrink();
+}
+
+///
+/// \return usage statistics (`collisions` is always `0`)
+///
+cache::statistics column_cache::stats() const
+{
+  std::lock_guard lock(mutex_);
+
+  cache::statistics ret;
+  ret.hits = hits_;
+  ret.misses = misses_;
+  ret.evictions = evictions_;
+
+  return ret;
+}
+
+///
+/// Discards the least recently used columns exceeding the capacity.
+///
+/// \warning The caller must hold the lock.
+///
+void column_cache::shrink()
+{
+  while (lru_.size() > capacity_)
+  {
+    index_.erase(lru_.back().key);
+    lru_.pop_back();
+    ++evictions_;
+  }
+}
+
+}  // namespace vita
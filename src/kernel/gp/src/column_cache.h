@@ -0,0 +1,97 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2024 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#if !defined(VITA_SRC_COLUMN_CACHE_H)
+#define      VITA_SRC_COLUMN_CACHE_H
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "kernel/cache.h"
+#include "kernel/gp/src/primitive/real_kernel.h"
+
+namespace vita
+{
+
+///
+/// A bounded LRU cache of real-valued columns (the outputs of an expression
+/// over a block of examples).
+///
+/// Offspring share most of their active code with their parents: the
+/// expressions starting at the shared loci have the same signature (see
+/// `i_mep::signature(const locus &)`) and, over the same block of examples,
+/// the same outputs. The batch interpreter looks up these outputs before
+/// computing an expression, so the cost of an evaluation mostly depends on
+/// the number of new expressions.
+///
+/// Keys combine the signature of an expression and an identifier of the
+/// block of examples. Least recently used columns are discarded first, so the
+/// cache follows the current population.
+///
+/// \warning
+/// The cache must be cleared when the content of the examples changes.
+///
+/// \remark
+/// The object can be used by many threads at the same time.
+///
+class column_cache
+{
+public:
+  explicit column_cache(std::size_t = 0);
+
+  column_cache(const column_cache &) = delete;
+  column_cache &operator=(const column_cache &) = delete;
+
+  void capacity(std::size_t);
+  [[nodiscard]] std::size_t capacity() const;
+  [[nodiscard]] std::size_t size() const;
+
+  void clear();
+
+  [[nodiscard]] static hash_t key(const hash_t &, const hash_t &);
+
+  [[nodiscard]] bool find(const hash_t &, real::column, std::size_t);
+  void insert(const hash_t &, real::const_column, std::size_t);
+
+  [[nodiscard]] cache::statistics stats() const;
+
+private:
+  struct entry
+  {
+    hash_t key;
+    std::vector<D_DOUBLE> val;
+    std::vector<real::mask_t> ok;
+  };
+
+  struct hasher
+  {
+    std::size_t operator()(const hash_t &h) const
+    { return static_cast<std::size_t>(h.data[0]); }
+  };
+
+  void shrink();
+
+  mutable std::mutex mutex_;
+
+  // Most recently used entries first.
+  std::list<entry> lru_;
+  std::unordered_map<hash_t, std::list<entry>::iterator, hasher> index_;
+
+  std::size_t capacity_;
+
+  std::uint64_t hits_, misses_, evictions_;
+};
+
+}  // namespace vita
+
+#endif  // include guard
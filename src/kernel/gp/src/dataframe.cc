@@ -11,12 +11,19 @@
  */
 
 #include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <thread>
 
 #include "kernel/gp/src/dataframe.h"
 #include "kernel/exceptions.h"
 #include "kernel/gp/symbol.h"
 #include "kernel/log.h"
 #include "kernel/random.h"
+#include "utility/mapped_file.h"
 
 #include "tinyxml2/tinyxml2.h"
 
@@ -43,6 +50,190 @@ value_t convert(const std::string &s, domain_t d)
   }
 }
 
+// \param[in] s the string to be converted
+// \param[in] d what type should `s` be converted in?
+// \return      the converted data
+//
+// Same result of `convert(std::string, domain_t)` but usually faster (there
+// isn't any memory allocation for numbers).
+value_t convert_view(std::string_view s, domain_t d)
+{
+  const auto parse([s](auto v) -> std::optional<value_t>
+  {
+    const auto *end(s.data() + s.size());
+
+    if (const auto [ptr, ec] = std::from_chars(s.data(), end, v);
+        ec == std::errc() && ptr == end)
+      return v;
+
+    return {};
+  });
+
+  switch (d)
+  {
+  case d_int:
+    if (const auto v = parse(D_INT()))
+      return *v;
+    break;
+  case d_double:
+    if (const auto v = parse(D_DOUBLE()))
+      return *v;
+    break;
+  case d_string:
+    return std::string(s);
+  default:
+    return {};
+  }
+
+  // Uncommon formats (e.g. leading `+`, hexadecimal numbers, infinity) and
+  // errors are managed by the general function.
+  return convert(std::string(s), d);
+}
+
+// \param[in] s the string to be tested
+// \return      `true` if `s` contains a number
+//
+// Same result of `is_number(std::string)` but usually faster.
+bool is_number_view(std::string_view s)
+{
+  s = pocket_csv::detail::trim_view(s);
+
+  D_DOUBLE v;
+  if (const auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), v);
+      ec == std::errc() && ptr == s.data() + s.size())
+    return true;
+
+  return is_number(std::string(s));
+}
+
+// \param[in,out] record fields of a CSV record
+// \param[in]     p      parameters used for reading the CSV data
+//
+// Moves the output field in the first position (or adds a surrogate, empty,
+// output field when the output index is unspecified).
+template<class R>
+void arrange_fields(R &record, const dataframe::params &p)
+{
+  if (p.output_index)
+  {
+    assert(p.output_index < record.size());
+    if (p.output_index > 0)
+      std::rotate(record.begin(),
+                  std::next(record.begin(), *p.output_index),
+                  std::next(record.begin(), *p.output_index + 1));
+  }
+  else
+    record.insert(record.begin(), typename R::value_type());
+}
+
+// Binary format (see `dataframe::write_binary`).
+constexpr char k_binary_magic[8] = {'V', 'I', 'T', 'A', 'D', 'F', '\0', '\1'};
+constexpr std::uint32_t k_binary_endianness = 0x01020304;
+constexpr std::size_t k_binary_alignment = 64;
+
+// Writes the elements of the binary format keeping track of the position (for
+// alignment).
+class binary_writer
+{
+public:
+  explicit binary_writer(std::ostream &out) : out_(out) {}
+
+  void bytes(const void *p, std::size_t n)
+  {
+    out_.write(static_cast<const char *>(p), static_cast<std::streamsize>(n));
+    pos_ += n;
+  }
+
+  template<class T> void pod(const T &v) { bytes(&v, sizeof(T)); }
+
+  void string(const std::string &s)
+  {
+    pod<std::uint64_t>(s.size());
+    bytes(s.data(), s.size());
+  }
+
+  void value(const value_t &v)
+  {
+    pod<std::uint8_t>(static_cast<std::uint8_t>(v.index()));
+
+    switch (v.index())
+    {
+    case d_int:    pod<std::int32_t>(std::get<D_INT>(v));  break;
+    case d_double: pod(std::get<D_DOUBLE>(v));             break;
+    case d_string: string(std::get<D_STRING>(v));          break;
+    default:                                               break;
+    }
+  }
+
+  void align()
+  {
+    while (pos_ % k_binary_alignment)
+      pod<char>(0);
+  }
+
+private:
+  std::ostream &out_;
+  std::size_t pos_ = 0;
+};
+
+// Reads the elements of the binary format from a memory buffer.
+class binary_reader
+{
+public:
+  binary_reader(const std::byte *data, std::size_t size)
+    : data_(data), size_(size)
+  {}
+
+  const std::byte *bytes(std::size_t n)
+  {
+    if (n > size_ - pos_)
+      throw exception::data_format("Truncated binary data file");
+
+    const auto *ret(data_ + pos_);
+    pos_ += n;
+    return ret;
+  }
+
+  template<class T> T pod()
+  {
+    T ret;
+    std::memcpy(&ret, bytes(sizeof(T)), sizeof(T));
+    return ret;
+  }
+
+  std::string string()
+  {
+    const auto n(pod<std::uint64_t>());
+    const auto *p(reinterpret_cast<const char *>(bytes(n)));
+    return std::string(p, n);
+  }
+
+  value_t value()
+  {
+    switch (pod<std::uint8_t>())
+    {
+    case d_void:   return {};
+    case d_int:    return static_cast<D_INT>(pod<std::int32_t>());
+    case d_double: return pod<D_DOUBLE>();
+    case d_string: return string();
+    default:
+      throw exception::data_format("Unknown value type in binary data file");
+    }
+  }
+
+  void align()
+  {
+    const auto extra(pos_ % k_binary_alignment);
+    if (extra)
+      bytes(k_binary_alignment - extra);
+  }
+
+private:
+  const std::byte *data_;
+  std::size_t size_;
+  std::size_t pos_ = 0;
+};
+
 }  // unnamed namespace
 
 ///
@@ -227,6 +418,7 @@ dataframe::dataframe(const std::filesystem::path &fn) : dataframe(fn, {}) {}
 void dataframe::clear()
 {
   dataset_.clear();
+  version_ = new_version();
 }
 
 ///
@@ -293,6 +485,32 @@ std::size_t dataframe::size() const
   return dataset_.size();
 }
 
+///
+/// \return an identifier of the current content of the dataframe
+///
+/// Every insertion / removal of examples gives the dataframe a new version,
+/// never used before by any dataframe. So the version (unlike the address of
+/// the dataframe or of its examples) can key cached data computed over the
+/// examples (see `column_cache`).
+///
+/// \warning
+/// Changes made in place, via iterators, to the input / output of an example
+/// aren't tracked.
+///
+std::uint64_t dataframe::version() const
+{
+  return version_;
+}
+
+///
+/// \return a version number never returned before
+///
+std::uint64_t dataframe::new_version()
+{
+  static std::atomic<std::uint64_t> last(0);
+  return ++last;
+}
+
 ///
 /// \return `true` if the dataframe is empty
 ///
@@ -332,6 +550,7 @@ unsigned dataframe::variables() const
 void dataframe::push_back(const example &e)
 {
   dataset_.push_back(e);
+  version_ = new_version();
 }
 
 ///
@@ -623,7 +842,223 @@ std::size_t dataframe::read_csv(const std::filesystem::path &fn,
   if (!in)
     throw std::runtime_error("Cannot read CSV data file");
 
-  return read_csv(in, p);
+  // Filters work on records owning their fields: the general, stream based,
+  // reader is required.
+  if (p.filter)
+    return read_csv(in, p);
+
+  in.close();
+
+  const mapped_file file(fn);
+  return parse_csv({reinterpret_cast<const char *>(file.data()), file.size()},
+                   p);
+}
+
+///
+/// Loads a memory buffer containing CSV data into the active dataset.
+///
+/// \param[in] text the CSV data
+/// \param[in] p    additional, optional, parameters (see `params` structure)
+/// \return         number of lines parsed (0 in case of errors)
+///
+/// \exception exception::insufficient_data empty / undersized data file
+///
+/// Same result of `read_csv(std::istream &, params)` but faster:
+/// - the dialect is sniffed on the first lines;
+/// - the first records (which also determine the domain of the columns) are
+///   loaded by the general algorithm;
+/// - the remaining data is parsed in parallel by `append_csv`.
+///
+std::size_t dataframe::parse_csv(std::string_view text, params p)
+{
+  clear();
+
+  if (p.dialect.has_header == pocket_csv::dialect::GUESS_HEADER
+      || !p.dialect.delimiter)
+  {
+    // The sniffer only examines the first lines.
+    std::size_t sample(0);
+    for (unsigned i(0); i < 64 && sample < text.size(); ++i)
+      if (const auto eol = text.find('\n', sample);
+          eol == std::string_view::npos)
+        sample = text.size();
+      else
+        sample = eol + 1;
+
+    std::istringstream in(std::string(text.substr(0, sample)));
+    const auto sniff(pocket_csv::sniffer(in));
+
+    if (p.dialect.has_header == pocket_csv::dialect::GUESS_HEADER)
+      p.dialect.has_header = sniff.has_header;
+    if (!p.dialect.delimiter)
+      p.dialect.delimiter = sniff.delimiter;
+  }
+
+  const bool has_header(p.dialect.has_header
+                        == pocket_csv::dialect::HAS_HEADER);
+
+  // The first records are used to build the columns' information.
+  pocket_csv::record_view fields;
+  std::deque<std::string> scratch;
+  for (std::size_t count(0); count < 10; ++count)
+  {
+    const auto line(pocket_csv::next_line(text));
+    if (line.empty())
+      break;
+
+    pocket_csv::split_line(line, p.dialect, fields, scratch);
+
+    record_t record(fields.begin(), fields.end());
+    arrange_fields(record, p);
+
+    columns.build(record, has_header);
+    if (has_header == false || count)
+      read_record(record, true);
+  }
+
+  if (!columns.empty())
+    append_csv(text, p);
+
+  if (!is_valid() || !size())
+    throw exception::insufficient_data("Empty / undersized CSV data file");
+
+  return size();
+}
+
+///
+/// Appends CSV data to the active dataset.
+///
+/// \param[in] text the CSV data (without header)
+/// \param[in] p    parameters used for reading the CSV data. The dialect must
+///                 be fully specified (delimiter and header known)
+/// \return         number of examples appended
+///
+/// The domain of the columns must be already known (e.g. previously read by
+/// `read_csv`): it's used to convert the records. Labels of classification
+/// examples and states of textual features are added to the metadata.
+///
+/// The data is split in chunks of complete lines parsed by different threads
+/// (see `params::threads`). Fields are `string_view`s of the input buffer and
+/// numbers are converted via `std::from_chars`. Chunks are merged in order,
+/// so class IDs follow the order of first appearance, exactly like the
+/// sequential reader.
+///
+std::size_t dataframe::append_csv(std::string_view text, const params &p)
+{
+  Expects(!columns.empty());
+  Expects(p.dialect.delimiter);
+
+  const auto before(size());
+
+  // Content of a chunk of the remaining data. Classification labels and
+  // states of textual features are collected separately since they change
+  // the dataframe.
+  struct chunk_data
+  {
+    examples_t examples = {};
+    std::vector<std::pair<std::size_t, std::string>> labels = {};
+    std::vector<std::set<std::string>> states = {};
+    std::vector<std::size_t> malformed = {};
+  };
+
+  const auto parse_chunk([&](std::string_view chunk)
+  {
+    chunk_data ret;
+    ret.states.resize(columns.size());
+
+    pocket_csv::record_view v;
+    std::deque<std::string> local_scratch;
+
+    for (auto line(pocket_csv::next_line(chunk)); !line.empty();
+         line = pocket_csv::next_line(chunk))
+    {
+      local_scratch.clear();
+      pocket_csv::split_line(line, p.dialect, v, local_scratch);
+      arrange_fields(v, p);
+
+      if (v.size() != columns.size())
+      {
+        ret.malformed.push_back(ret.examples.size());
+        continue;
+      }
+
+      // Same conversion of `to_example`.
+      example e;
+      e.input.reserve(v.size());
+
+      for (std::size_t i(0); i < v.size(); ++i)
+        if (const auto domain = columns[i].domain; domain != d_void)
+        {
+          const auto feature(pocket_csv::detail::trim_view(v[i]));
+
+          if (i == 0)
+          {
+            if (!is_number_view(v.front()))  // classification
+              ret.labels.emplace_back(ret.examples.size(), feature);
+            else
+              e.output = convert_view(feature, domain);
+          }
+          else
+            e.input.push_back(convert_view(feature, domain));
+
+          if (domain == d_string)
+            ret.states[i].emplace(feature);
+        }
+
+      ret.examples.push_back(std::move(e));
+    }
+
+    return ret;
+  });
+
+  std::size_t threads(p.threads);
+  if (!threads)
+    threads = std::max<std::size_t>(
+      std::min<std::size_t>(text.size() >> 20,
+                            std::thread::hardware_concurrency()), 1);
+
+  std::vector<std::future<chunk_data>> parts;
+  for (const auto &chunk : pocket_csv::split_chunks(text, threads))
+    parts.push_back(std::async(threads > 1 ? std::launch::async
+                                           : std::launch::deferred,
+                               parse_chunk, chunk));
+
+  for (auto &part : parts)
+  {
+    auto data(part.get());
+
+    auto malformed(data.malformed.begin());
+    const auto warn_malformed([&](std::size_t i)
+    {
+      for (; malformed != data.malformed.end() && *malformed == i;
+           ++malformed)
+        vitaWARNING << "Malformed exampled " << size() <<  " skipped";
+    });
+
+    auto label(data.labels.begin());
+    dataset_.reserve(size() + data.examples.size());
+
+    for (std::size_t i(0); i < data.examples.size(); ++i)
+    {
+      warn_malformed(i);
+
+      if (label != data.labels.end() && label->first == i)
+      {
+        data.examples[i].output = static_cast<D_INT>(encode(label->second));
+        ++label;
+      }
+
+      dataset_.push_back(std::move(data.examples[i]));
+    }
+    warn_malformed(data.examples.size());
+    version_ = new_version();
+
+    for (std::size_t i(0); i < columns.size(); ++i)
+      for (const auto &s : data.states[i])
+        columns[i].states.insert(s);
+  }
+
+  return size() - before;
 }
 
 ///
@@ -731,10 +1166,15 @@ std::size_t dataframe::read_csv(std::istream &from)
 ///
 /// Loads the content of a file into the active dataset.
 ///
-/// \param[in] fn name of the file containing the data set (CSV / XRFF format)
-/// \param[in] p  additional, optional, parameters (see `params` structure)
+/// \param[in] fn name of the file containing the data set (CSV / XRFF /
+///               binary format)
+/// \param[in] p  additional, optional, parameters (see `params` structure).
+///               Unused for the binary format
 /// \return       number of lines parsed
 ///
+/// The format is deduced from the extension of the file (`.xrff` / `.xml`
+/// for XRFF, `.vdf` for the binary format, CSV otherwise).
+///
 /// \exception std::invalid_argument missing dataset file name
 ///
 /// \note Test set can have an empty output value.
@@ -745,6 +1185,10 @@ std::size_t dataframe::read(const std::filesystem::path &fn, const params &p)
     throw std::invalid_argument("Missing dataset filename");
 
   const auto ext(fn.extension().string());
+
+  if (iequals(ext, ".vdf"))
+    return read_binary(fn);
+
   const bool xrff(iequals(ext, ".xrff") || iequals(ext, ".xml"));
 
   return xrff ? read_xrff(fn, p) : read_csv(fn, p);
@@ -754,6 +1198,283 @@ std::size_t dataframe::read(const std::filesystem::path &fn)
   return read(fn, {});
 }
 
+///
+/// Saves the dataframe in a binary format.
+///
+/// \param[in] fn name of the output file (the conventional extension is
+///               `.vdf`)
+///
+/// \exception std::runtime_error    cannot write the file
+/// \exception exception::data_format a column contains values of different
+///                                   types
+///
+/// The file contains the metadata (`columns`, class names) followed by the
+/// values of the examples stored column by column, in blocks aligned to
+/// 64 bytes:
+/// - `d_double` columns are arrays of doubles;
+/// - `d_int` columns are arrays of 32 bit integers;
+/// - `d_string` columns are a dictionary of the distinct strings followed by
+///   an array of 32 bit indices.
+///
+/// Numbers are stored in the byte order of the machine writing the file.
+/// Reading (see `read_binary`) is a sequence of memory copies: there isn't
+/// any text parsing. The typical work flow is a one-time conversion of a
+/// large CSV / XRFF file followed by many fast loads.
+///
+/// \remark
+/// `difficulty` and `age` of the examples aren't saved.
+///
+void dataframe::write_binary(const std::filesystem::path &fn) const
+{
+  // Type of the values of every column (output first). Taken from the first
+  // example (an empty dataframe has just a `d_void` output column).
+  std::vector<std::uint8_t> kinds;
+  for (const auto &e : dataset_)
+  {
+    if (kinds.empty())
+    {
+      kinds.push_back(static_cast<std::uint8_t>(e.output.index()));
+      for (const auto &v : e.input)
+        kinds.push_back(static_cast<std::uint8_t>(v.index()));
+    }
+
+    if (e.input.size() + 1 != kinds.size())
+      throw exception::data_format("Examples of different arity");
+
+    if (e.output.index() != kinds[0])
+      throw exception::data_format("Mixed types in the output column");
+
+    for (std::size_t i(0); i < e.input.size(); ++i)
+      if (e.input[i].index() != kinds[i + 1])
+        throw exception::data_format("Mixed types in the same column");
+  }
+
+  if (kinds.empty())
+    kinds.push_back(d_void);
+  const std::size_t inputs(kinds.size() - 1);
+
+  std::ofstream out(fn, std::ios::binary);
+  if (!out)
+    throw std::runtime_error("Cannot write binary data file");
+
+  binary_writer w(out);
+
+  w.bytes(k_binary_magic, sizeof(k_binary_magic));
+  w.pod(k_binary_endianness);
+
+  // Metadata.
+  w.pod<std::uint64_t>(columns.size());
+  for (const auto &c : columns)
+  {
+    w.string(c.name);
+    w.pod<std::uint8_t>(c.domain);
+    w.pod<std::uint64_t>(c.states.size());
+    for (const auto &s : c.states)
+      w.value(s);
+  }
+
+  w.pod<std::uint64_t>(classes_map_.size());
+  for (const auto &[name, id] : classes_map_)
+  {
+    w.string(name);
+    w.pod<std::uint64_t>(id);
+  }
+
+  w.pod<std::uint64_t>(size());
+  w.pod<std::uint64_t>(inputs);
+  w.bytes(kinds.data(), kinds.size());
+
+  // Values.
+  const auto get([this](std::size_t row, std::size_t col) -> const value_t &
+                 {
+                   const auto &e(dataset_[row]);
+                   return col ? e.input[col - 1] : e.output;
+                 });
+
+  for (std::size_t c(0); c < kinds.size(); ++c)
+  {
+    w.align();
+
+    switch (kinds[c])
+    {
+    case d_int:
+      for (std::size_t r(0); r < size(); ++r)
+        w.pod<std::int32_t>(std::get<D_INT>(get(r, c)));
+      break;
+
+    case d_double:
+      for (std::size_t r(0); r < size(); ++r)
+        w.pod(std::get<D_DOUBLE>(get(r, c)));
+      break;
+
+    case d_string:
+    {
+      std::map<std::string, std::uint32_t> index;
+      std::vector<const std::string *> dictionary;
+      for (std::size_t r(0); r < size(); ++r)
+      {
+        const auto &s(std::get<D_STRING>(get(r, c)));
+        if (index.try_emplace(
+              s, static_cast<std::uint32_t>(dictionary.size())).second)
+          dictionary.push_back(&s);
+      }
+
+      w.pod<std::uint64_t>(dictionary.size());
+      for (const auto *s : dictionary)
+        w.string(*s);
+
+      w.align();
+      for (std::size_t r(0); r < size(); ++r)
+        w.pod(index.at(std::get<D_STRING>(get(r, c))));
+      break;
+    }
+
+    default:
+      break;
+    }
+  }
+
+  w.align();
+
+  if (!out)
+    throw std::runtime_error("Cannot write binary data file");
+}
+
+///
+/// Loads a binary data file (see `write_binary`) into the active dataset.
+///
+/// \param[in] fn name of the binary data file
+/// \return       number of examples read
+///
+/// \exception std::runtime_error            cannot read the file
+/// \exception exception::data_format        wrong data format
+/// \exception exception::insufficient_data  empty data file
+///
+/// The file is memory mapped: there isn't any parsing and pages are shared
+/// among the processes reading the same file.
+///
+std::size_t dataframe::read_binary(const std::filesystem::path &fn)
+{
+  clear();
+  columns = columns_info();
+  classes_map_.clear();
+
+  const mapped_file file(fn);
+  binary_reader r(file.data(), file.size());
+
+  if (std::memcmp(r.bytes(sizeof(k_binary_magic)), k_binary_magic,
+                  sizeof(k_binary_magic)))
+    throw exception::data_format("Not a binary data file");
+
+  if (r.pod<std::uint32_t>() != k_binary_endianness)
+    throw exception::data_format("Binary data file with wrong byte order");
+
+  // Metadata.
+  for (auto n(r.pod<std::uint64_t>()); n; --n)
+  {
+    columns_info::column_info c;
+    c.name = r.string();
+    c.domain = static_cast<domain_t>(r.pod<std::uint8_t>());
+
+    for (auto s(r.pod<std::uint64_t>()); s; --s)
+      c.states.insert(r.value());
+
+    columns.push_back(c);
+  }
+
+  for (auto n(r.pod<std::uint64_t>()); n; --n)
+  {
+    auto name(r.string());
+    classes_map_[std::move(name)] = r.pod<std::uint64_t>();
+  }
+
+  const auto rows(r.pod<std::uint64_t>());
+  const auto inputs(r.pod<std::uint64_t>());
+  const auto *kinds(r.bytes(inputs + 1));
+
+  // Every example requires at least some bytes: protects from huge
+  // allocations caused by a corrupted file.
+  if (rows > file.size())
+    throw exception::data_format("Wrong number of examples in binary data");
+
+  dataset_.resize(rows);
+  for (auto &e : dataset_)
+    e.input.resize(inputs);
+  version_ = new_version();
+
+  // Values.
+  const auto cell([this](std::size_t row, std::size_t col) -> value_t &
+                  {
+                    auto &e(dataset_[row]);
+                    return col ? e.input[col - 1] : e.output;
+                  });
+
+  for (std::size_t c(0); c <= inputs; ++c)
+  {
+    r.align();
+
+    switch (std::to_integer<int>(kinds[c]))
+    {
+    case d_void:
+      break;
+
+    case d_int:
+    {
+      const auto *p(r.bytes(rows * sizeof(std::int32_t)));
+      for (std::size_t i(0); i < rows; ++i)
+      {
+        std::int32_t v;
+        std::memcpy(&v, p + i * sizeof(v), sizeof(v));
+        cell(i, c) = static_cast<D_INT>(v);
+      }
+      break;
+    }
+
+    case d_double:
+    {
+      const auto *p(r.bytes(rows * sizeof(D_DOUBLE)));
+      for (std::size_t i(0); i < rows; ++i)
+      {
+        D_DOUBLE v;
+        std::memcpy(&v, p + i * sizeof(v), sizeof(v));
+        cell(i, c) = v;
+      }
+      break;
+    }
+
+    case d_string:
+    {
+      std::vector<std::string> dictionary(r.pod<std::uint64_t>());
+      for (auto &s : dictionary)
+        s = r.string();
+
+      r.align();
+      const auto *p(r.bytes(rows * sizeof(std::uint32_t)));
+      for (std::size_t i(0); i < rows; ++i)
+      {
+        std::uint32_t v;
+        std::memcpy(&v, p + i * sizeof(v), sizeof(v));
+        if (v >= dictionary.size())
+          throw exception::data_format("Wrong string index in binary data");
+
+        cell(i, c) = dictionary[v];
+      }
+      break;
+    }
+
+    default:
+      throw exception::data_format("Unknown column type in binary data file");
+    }
+  }
+
+  if (!is_valid())
+    throw exception::data_format("Inconsistent binary data file");
+  if (!size())
+    throw exception::insufficient_data("Empty binary data file");
+
+  return size();
+}
+
 ///
 /// \return `true` if the current dataset is empty
 ///
@@ -771,6 +1492,7 @@ bool dataframe::operator!() const
 ///
 dataframe::iterator dataframe::erase(iterator first, iterator last)
 {
+  version_ = new_version();
   return dataset_.erase(first, last);
 }
 
@@ -802,4 +1524,215 @@ bool dataframe::is_valid() const
   return columns.is_valid();
 }
 
+///
+/// \param[in] i index of an example
+/// \return      the value of the column for the `i`-th example
+///
+value_t dataframe::columnar::column::operator[](std::size_t i) const
+{
+  switch (domain)
+  {
+  case d_int:    return integer[i];
+  case d_double: return real[i];
+  case d_string: return dictionary[code[i]];
+  default:       return {};
+  }
+}
+
+///
+/// Builds the columnar representation of a dataframe.
+///
+/// \param[in] d a dataframe
+///
+/// \exception exception::data_format a column contains values of different
+///                                   types
+///
+dataframe::columnar::columnar(const dataframe &d) : version_(d.version())
+{
+  const auto n(d.size());
+
+  difficulty.reserve(n);
+  age.reserve(n);
+
+  if (d.empty())
+    return;
+
+  const auto prepare([n](column &c, const value_t &first)
+                     {
+                       c.domain = static_cast<domain_t>(first.index());
+
+                       switch (c.domain)
+                       {
+                       case d_int:    c.integer.reserve(n); break;
+                       case d_double: c.real.reserve(n);    break;
+                       case d_string: c.code.reserve(n);    break;
+                       default:                             break;
+                       }
+                     });
+
+  // Values of a `d_string` column are stored only once.
+  std::vector<std::map<std::string, std::uint32_t>> dictionaries;
+
+  const auto append([&dictionaries](column &c, std::size_t ci,
+                                    const value_t &v)
+  {
+    if (static_cast<domain_t>(v.index()) != c.domain)
+      throw exception::data_format("Mixed types in the same column");
+
+    switch (c.domain)
+    {
+    case d_int:
+      c.integer.push_back(std::get<D_INT>(v));
+      break;
+    case d_double:
+      c.real.push_back(std::get<D_DOUBLE>(v));
+      break;
+    case d_string:
+    {
+      const auto &s(std::get<D_STRING>(v));
+      const auto [it, inserted] = dictionaries[ci].try_emplace(
+        s, static_cast<std::uint32_t>(c.dictionary.size()));
+      if (inserted)
+        c.dictionary.push_back(s);
+      c.code.push_back(it->second);
+      break;
+    }
+    default:
+      break;
+    }
+  });
+
+  const auto &first(d.front());
+  inputs_.resize(first.input.size());
+  dictionaries.resize(inputs_.size() + 1);
+
+  for (std::size_t i(0); i < inputs_.size(); ++i)
+    prepare(inputs_[i], first.input[i]);
+  prepare(output_, first.output);
+
+  for (const auto &e : d)
+  {
+    if (e.input.size() != inputs_.size())
+      throw exception::data_format("Examples of different arity");
+
+    for (std::size_t i(0); i < inputs_.size(); ++i)
+      append(inputs_[i], i, e.input[i]);
+    append(output_, inputs_.size(), e.output);
+
+    difficulty.push_back(e.difficulty);
+    age.push_back(e.age);
+  }
+
+  Ensures(is_valid());
+}
+
+///
+/// \return number of examples
+///
+std::size_t dataframe::columnar::size() const
+{
+  return difficulty.size();
+}
+
+///
+/// \return `true` if there aren't examples
+///
+bool dataframe::columnar::empty() const
+{
+  return size() == 0;
+}
+
+///
+/// \return input vector dimension
+///
+unsigned dataframe::columnar::variables() const
+{
+  return static_cast<unsigned>(inputs_.size());
+}
+
+///
+/// \return the version of the source dataframe (see `dataframe::version()`)
+///
+std::uint64_t dataframe::columnar::version() const
+{
+  return version_;
+}
+
+///
+/// \param[in] i index of a feature
+/// \return      the values of the `i`-th feature
+///
+const dataframe::columnar::column &dataframe::columnar::input(
+  std::size_t i) const
+{
+  Expects(i < inputs_.size());
+  return inputs_[i];
+}
+
+///
+/// \return the labels of the examples
+///
+const dataframe::columnar::column &dataframe::columnar::output() const
+{
+  return output_;
+}
+
+///
+/// \param[in] i index of an example
+/// \return      the input vector of the `i`-th example
+///
+/// \remark
+/// Used only where a single row is needed. Avoid it in hot loops.
+///
+std::vector<value_t> dataframe::columnar::row(std::size_t i) const
+{
+  Expects(i < size());
+
+  std::vector<value_t> ret;
+  ret.reserve(inputs_.size());
+
+  for (const auto &c : inputs_)
+    ret.push_back(c[i]);
+
+  return ret;
+}
+
+///
+/// \return `true` if the object passes the internal consistency check
+///
+bool dataframe::columnar::is_valid() const
+{
+  const auto length([](const column &c) -> std::size_t
+                    {
+                      switch (c.domain)
+                      {
+                      case d_int:    return c.integer.size();
+                      case d_double: return c.real.size();
+                      case d_string: return c.code.size();
+                      default:       return 0;
+                      }
+                    });
+
+  if (age.size() != difficulty.size())
+  {
+    vitaERROR << "Age and difficulty arrays have different sizes";
+    return false;
+  }
+
+  for (const auto &c : inputs_)
+    if (length(c) != size())
+    {
+      vitaERROR << "Wrong column length";
+      return false;
+    }
+
+  if (output_.domain != d_void && length(output_) != size())
+  {
+    vitaERROR << "Wrong label column length";
+    return false;
+  }
+
+  return true;
+}
+
 }  // namespace vita
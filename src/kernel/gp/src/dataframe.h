@@ -19,10 +19,12 @@
 #include <optional>
 #include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "kernel/distribution.h"
 #include "kernel/problem.h"
+#include "utility/aligned_allocator.h"
 #include "utility/pocket_csv.h"
 
 namespace vita
@@ -40,7 +42,8 @@ using class_t = std::size_t;
 /// - is modelled on the corresponding *pandas* object;
 /// - is a forward iterable collection of "monomorphic" examples (all samples
 ///   have the same type and arity);
-/// - accepts many different kinds of input: CSV and XRFF files.
+/// - accepts many different kinds of input: CSV and XRFF files, plus a
+///   memory mapped binary format for fast loading (see `write_binary`).
 ///
 /// \see https://github.com/morinim/vita/wiki/dataframe
 ///
@@ -49,6 +52,7 @@ class dataframe
 public:
   // ---- Structures ----
   struct example;
+  class columnar;
   class params;
 
   // ---- Aliases ----
@@ -140,6 +144,9 @@ public:
   std::size_t read_csv(std::istream &, params);
   std::size_t read_xrff(std::istream &);
   std::size_t read_xrff(std::istream &, const params &);
+  std::size_t append_csv(std::string_view, const params &);
+  std::size_t read_binary(const std::filesystem::path &);
+  void write_binary(const std::filesystem::path &) const;
   bool operator!() const;
 
   void push_back(const example &);
@@ -147,6 +154,8 @@ public:
   std::size_t size() const;
   bool empty() const;
 
+  std::uint64_t version() const;
+
   class_t classes() const;
   unsigned variables() const;
 
@@ -163,9 +172,12 @@ private:
   class_t encode(const std::string &);
 
   std::size_t read_csv(const std::filesystem::path &, const params &);
+  std::size_t parse_csv(std::string_view, params);
   std::size_t read_xrff(const std::filesystem::path &, const params &);
   std::size_t read_xrff(tinyxml2::XMLDocument &, const params &);
 
+  static std::uint64_t new_version();
+
   // Integer are simpler to manage than textual data, so, when appropriate,
   // input strings are converted into integers by this map and the `encode`
   // static function.
@@ -173,6 +185,9 @@ private:
 
   // Available data.
   examples_t dataset_;
+
+  // Identifies the current content of `dataset_` (see `version()`).
+  std::uint64_t version_ = new_version();
 };
 
 domain_t from_weka(const std::string &);
@@ -234,6 +249,70 @@ inline class_t label(const dataframe::example &e)
   return std::get<D_INT>(e.output);
 }
 
+///
+/// Structure-of-arrays (columnar) copy of a dataframe.
+///
+/// Every feature is stored in its own contiguous, cache line aligned array
+/// (`double` / `int` values or dictionary-encoded strings). Labels,
+/// difficulty and age are separate arrays too.
+///
+/// Compared to a vector of `example`s there isn't a heap block per row nor a
+/// `value_t` per value: memory usage is several times smaller and a block of
+/// rows of a numeric feature can be copied (or processed by SIMD
+/// instructions) directly.
+///
+/// \remark
+/// This is a snapshot: later changes of the source dataframe aren't
+/// reflected.
+///
+class dataframe::columnar
+{
+public:
+  /// A single feature (or the label) of every example.
+  struct column
+  {
+    /// Type of the values (`d_void` for a missing label).
+    domain_t domain = d_void;
+    /// Values of a `d_double` column.
+    aligned_vector<D_DOUBLE> real = {};
+    /// Values of a `d_int` column.
+    aligned_vector<D_INT> integer = {};
+    /// Values of a `d_string` column (indices in `dictionary`).
+    aligned_vector<std::uint32_t> code = {};
+    /// Distinct strings of a `d_string` column.
+    std::vector<std::string> dictionary = {};
+
+    [[nodiscard]] value_t operator[](std::size_t) const;
+  };
+
+  columnar() = default;
+  explicit columnar(const dataframe &);
+
+  [[nodiscard]] std::size_t size() const;
+  [[nodiscard]] bool empty() const;
+  [[nodiscard]] unsigned variables() const;
+  [[nodiscard]] std::uint64_t version() const;
+
+  [[nodiscard]] const column &input(std::size_t) const;
+  [[nodiscard]] const column &output() const;
+
+  [[nodiscard]] std::vector<value_t> row(std::size_t) const;
+
+  [[nodiscard]] bool is_valid() const;
+
+  /// Difficulty of every example (see `example::difficulty`).
+  std::vector<std::uintmax_t> difficulty = {};
+  /// Age of every example (see `example::age`).
+  std::vector<unsigned> age = {};
+
+private:
+  std::vector<column> inputs_ = {};
+  column output_ = {};
+
+  // Version of the source dataframe when the snapshot was taken.
+  std::uint64_t version_ = 0;
+};
+
 class dataframe::params
 {
 public:
@@ -254,6 +333,11 @@ public:
   /// Index of the column containing the output value (label).
   /// \remark Used only when reading CSV files.
   std::optional<std::size_t> output_index = 0;
+
+  /// Number of threads parsing a CSV file (`0` for an automatic choice based
+  /// on the size of the file).
+  /// \remark Used only when reading CSV files (not streams) without filter.
+  unsigned threads = 0;
 };
 
 }  // namespace vita
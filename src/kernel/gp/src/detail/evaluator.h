@@ -33,6 +33,36 @@ struct is_iterable<T, std::void_t<decltype(std::declval<T>().begin()),
 template<class T>
 constexpr bool is_iterable_v = is_iterable<T>::value;
 
+///
+/// `true` for the structure-of-arrays version of the dataframe (which isn't
+/// a collection of examples).
+///
+template<class T>
+constexpr bool is_columnar_v = std::is_same_v<T, dataframe::columnar>;
+
+///
+/// A trait to check if a dataset is read block by block (see
+/// `streamed_dataframe`). Such datasets can only be scanned sequentially, one
+/// block (`T::block_t`) at a time.
+///
+template<class T, class = void> struct is_streamed : std::false_type {};
+
+template<class T>
+struct is_streamed<T, std::void_t<typename T::block_t>> : std::true_type {};
+
+template<class T>
+constexpr bool is_streamed_v = is_streamed<T>::value;
+
+///
+/// A trait to check if the examples of a dataset can be accessed by index
+/// (required for the data parallel evaluation).
+///
+template<class T>
+constexpr bool is_random_access_v = std::is_base_of_v<
+  std::random_access_iterator_tag,
+  typename std::iterator_traits<
+    decltype(std::begin(std::declval<T &>()))>::iterator_category>;
+
 ///
 /// A trait to check if a container has the `classes` method.
 ///
@@ -53,6 +83,27 @@ template<class DAT> std::size_t classes(const DAT &d)
   return 0;
 }
 
+///
+/// A trait to check if a container has the `version` method (see
+/// `dataframe::version()`).
+///
+template<class T, class = void> struct has_version : std::false_type {};
+
+template<class T>
+struct has_version<T, std::void_t<decltype(std::declval<T>().version())>>
+  : std::true_type {};
+
+template<class T>
+constexpr bool has_version_v = has_version<T>::value;
+
+template<class DAT> std::uint64_t version(const DAT &d)
+{
+  if constexpr (has_version_v<DAT>)
+    return d.version();
+
+  return 0;
+}
+
 ///
 /// A trait to check if an example has an incrementable `difficulty` field.
 ///
@@ -73,6 +124,68 @@ template<class ERRF, class DAT>
 constexpr bool is_error_functor_v =
   std::is_invocable_r_v<double, ERRF, decltype(*std::declval<DAT>().begin())>;
 
+///
+/// A trait to check if `ERRF` can measure the error of an already computed
+/// model value (`ERRF::error(value, example)`). Such functors support batch
+/// evaluation (see vita::batch_interpreter).
+///
+template<class ERRF, class DAT, class = void>
+struct is_batch_error_functor : std::false_type {};
+
+template<class ERRF, class DAT>
+struct is_batch_error_functor<
+  ERRF, DAT,
+  std::void_t<decltype(ERRF::error(std::declval<value_t>(),
+                                   *std::declval<DAT>().begin()))>>
+  : std::true_type {};
+
+template<class ERRF, class DAT>
+constexpr bool is_batch_error_functor_v =
+  is_batch_error_functor<ERRF, DAT>::value;
+
+///
+/// \return `true` if `ERRF` can measure the errors on the examples of `DAT`
+///
+/// A columnar dataset has no example objects: the error functor must support
+/// batch evaluation.
+///
+template<class ERRF, class DAT>
+constexpr bool accepts_error_functor()
+{
+  if constexpr (is_columnar_v<DAT>)
+    return is_batch_error_functor_v<ERRF, dataframe>;
+  else
+    return is_error_functor_v<ERRF, DAT>;
+}
+
+///
+/// Combines the mean values of consecutive partitions of a dataset.
+///
+/// \param[in] first beginning of a range of `{mean, count}` pairs
+/// \param[in] last  end of the range
+/// \return          the `{mean, count}` pair of the union of the partitions
+///
+/// Partitions are combined in pairs, recursively. As for `pairwise_sum` the
+/// result only depends on the sequence of partial results but, unlike a sum,
+/// it cannot overflow when single errors are huge (e.g. penalties).
+///
+template<class It>
+std::pair<double, double> pairwise_mean(It first, It last)
+{
+  const auto n(std::distance(first, last));
+  if (n == 0)
+    return {0.0, 0.0};
+  if (n == 1)
+    return *first;
+
+  const auto middle(std::next(first, n / 2));
+  const auto [m1, n1] = pairwise_mean(first, middle);
+  const auto [m2, n2] = pairwise_mean(middle, last);
+
+  const auto count(n1 + n2);
+  return {count > 0.0 ? m1 + (m2 - m1) * (n2 / count) : 0.0, count};
+}
+
 }  // namespace vita::detail
 
 #endif  // include guard
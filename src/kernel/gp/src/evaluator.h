@@ -14,7 +14,9 @@
 #define      VITA_SRC_EVALUATOR_H
 
 #include "kernel/evaluator.h"
+#include "kernel/gp/src/batch_interpreter.h"
 #include "kernel/gp/src/detail/evaluator.h"
+#include "utility/thread_pool.h"
 
 namespace vita
 {
@@ -23,7 +25,8 @@ namespace vita
 /// An evaluator specialized for symbolic regression / classification problems.
 ///
 /// \tparam T   type of individual
-/// \tparam DAT type of the dataset
+/// \tparam DAT type of the dataset (an iterable collection of examples, a
+///             dataframe::columnar or a streamed_dataframe)
 ///
 /// This specialization of the evaluator class is "dataset-aware". It's useful
 /// to group common factors of more specialized symbolic regression or
@@ -33,12 +36,39 @@ template<class T, class DAT = dataframe>
 class src_evaluator : public evaluator<T>
 {
 public:
-  static_assert(detail::is_iterable_v<DAT>);
+  static_assert(detail::is_iterable_v<DAT> || detail::is_columnar_v<DAT>);
 
   explicit src_evaluator(DAT &);
 
+  void data_parallel(bool);
+  [[nodiscard]] bool data_parallel() const;
+
+  void subtree_cache(std::size_t);
+  [[nodiscard]] std::optional<cache::statistics> subtree_cache_stats() const;
+
+  void clear() override;
+  hash_t fingerprint(const T &, unsigned) override;
+  void read_only(bool) override;
+  [[nodiscard]] bool read_only() const override;
+
+  /// Examples per partition of the dataset in data parallel mode.
+  static constexpr std::size_t partition_size =
+    4 * batch_interpreter::block_size;
+
 protected:
+  [[nodiscard]] std::size_t partitions(std::size_t) const;
+
   DAT *dat_;
+
+  // Partitions of the dataset are evaluated by the shared thread pool.
+  bool data_parallel_ = false;
+
+  // The difficulty of the examples isn't updated (see `read_only`).
+  bool read_only_ = false;
+
+  // Outputs of the expressions shared among the evaluated programs (see
+  // `subtree_cache`). Copies of the evaluator share the same cache.
+  std::shared_ptr<column_cache> columns_ = nullptr;
 };
 
 ///
@@ -60,17 +90,24 @@ class sum_of_errors_evaluator : public src_evaluator<T, DAT>
 {
 public:
   static_assert(std::is_class_v<ERRF>);
-  static_assert(detail::is_iterable_v<DAT>);
-  static_assert(detail::is_error_functor_v<ERRF, DAT>);
+  static_assert(detail::is_iterable_v<DAT> || detail::is_columnar_v<DAT>);
+  static_assert(detail::accepts_error_functor<ERRF, DAT>());
 
   explicit sum_of_errors_evaluator(DAT &);
 
   fitness_t operator()(const T &) override;
   fitness_t fast(const T &) override;
+  race_result race(const T &, const fitness_t &) override;
   std::unique_ptr<basic_lambda_f> lambdify(const T &) const override;
 
 private:
-  fitness_t sum_of_errors_impl(const T &, unsigned);
+  race_result sum_of_errors_impl(
+    const T &, unsigned, double = std::numeric_limits<double>::infinity());
+  [[nodiscard]] double race_examples(unsigned, double) const;
+  race_result batch_sum_of_errors(const i_mep &, unsigned, double);
+  fitness_t columnar_sum_of_errors(const T &, unsigned);
+  fitness_t streamed_sum_of_errors(const T &, unsigned);
+  fitness_t parallel_sum_of_errors(const T &, unsigned);
 };
 
 ///
@@ -92,6 +129,8 @@ public:
 
   double operator()(const dataframe::example &) const;
 
+  static double error(const value_t &, const dataframe::example &);
+
 private:
   basic_reg_lambda_f<T, false> agent_;
 };
@@ -134,6 +173,8 @@ public:
 
   double operator()(const dataframe::example &) const;
 
+  static double error(const value_t &, const dataframe::example &);
+
 private:
   basic_reg_lambda_f<T, false> agent_;
 };
@@ -182,6 +223,8 @@ public:
 
   double operator()(const dataframe::example &) const;
 
+  static double error(const value_t &, const dataframe::example &);
+
 private:
   basic_reg_lambda_f<T, false> agent_;
 };
@@ -215,6 +258,8 @@ public:
 
   double operator()(const dataframe::example &) const;
 
+  static double error(const value_t &, const dataframe::example &);
+
 private:
   basic_reg_lambda_f<T, false> agent_;
 };
@@ -240,6 +285,10 @@ class classification_evaluator : public src_evaluator<T>
 {
 public:
   explicit classification_evaluator(dataframe &d) : src_evaluator<T>(d) {}
+
+protected:
+  template<class L, class F> fitness_t::value_type sum_over_examples(
+    const L &, F);
 };
 
 ///
@@ -25,6 +25,208 @@ src_evaluator<T, DAT>::src_evaluator(DAT &d) : dat_(&d)
 {
 }
 
+///
+/// Enables / disables the data parallel evaluation.
+///
+/// \param[in] v `true` to split the dataset in partitions evaluated by the
+///              shared thread pool
+///
+/// Partitions (see `partition_size`) only depend on the size of the dataset
+/// and their partial results are reduced via a pairwise sum: the fitness
+/// doesn't depend on the number of threads.
+///
+/// \remark
+/// The order of the operations differs from the sequential evaluation, so the
+/// fitness may differ in the last digits from the one obtained with the
+/// data parallel mode disabled.
+///
+template<class T, class DAT>
+void src_evaluator<T, DAT>::data_parallel(bool v)
+{
+  data_parallel_ = v;
+}
+
+///
+/// \return `true` if the data parallel evaluation is enabled
+///
+template<class T, class DAT>
+bool src_evaluator<T, DAT>::data_parallel() const
+{
+  return data_parallel_;
+}
+
+///
+/// Enables / disables the update of the difficulty of the examples.
+///
+/// \param[in] v `true` to leave the difficulty of the examples unchanged
+///
+/// The difficulty is only used by DSS. In read-only mode the evaluator can be
+/// called by many threads at the same time (see `environment::threads`).
+///
+template<class T, class DAT>
+void src_evaluator<T, DAT>::read_only(bool v)
+{
+  read_only_ = v;
+}
+
+///
+/// \return `true` if the difficulty of the examples isn't updated
+///
+template<class T, class DAT>
+bool src_evaluator<T, DAT>::read_only() const
+{
+  return read_only_;
+}
+
+///
+/// Enables / disables the sharing of subexpression outputs.
+///
+/// \param[in] columns maximum number of columns (outputs of an expression
+///                    over a block of examples) kept in memory. `0` disables
+///                    the cache
+///
+/// Offspring share most of their active code with their parents. With the
+/// cache enabled, the batch interpreter reuses the outputs of expressions
+/// already computed for other programs (see vita::column_cache), so the cost
+/// of an evaluation is roughly proportional to the number of new loci.
+///
+/// \remark
+/// - Only i_mep individuals evaluated via vectorised kernels use the cache
+///   (streamed datasets and datasets without a `version()` are excluded).
+/// - Blocks of examples are keyed by the version of the dataset, so columns
+///   computed before an insertion / removal of examples are never reused.
+///   In place changes of the examples must be followed by a call to
+///   `clear()` (as for the fitness cache).
+///
+template<class T, class DAT>
+void src_evaluator<T, DAT>::subtree_cache(std::size_t columns)
+{
+  if (!columns)
+    columns_ = nullptr;
+  else if (columns_)
+    columns_->capacity(columns);
+  else
+    columns_ = std::make_shared<column_cache>(columns);
+}
+
+///
+/// \return usage statistics of the subtree cache (if enabled)
+///
+template<class T, class DAT>
+std::optional<cache::statistics> src_evaluator<T, DAT>::subtree_cache_stats()
+  const
+{
+  if (columns_)
+    return columns_->stats();
+  return {};
+}
+
+///
+/// Discards the outputs stored in the subtree cache.
+///
+template<class T, class DAT>
+void src_evaluator<T, DAT>::clear()
+{
+  if (columns_)
+    columns_->clear();
+}
+
+///
+/// \param[in] n number of examples to be evaluated
+/// \return      number of partitions for `n` examples
+///
+template<class T, class DAT>
+std::size_t src_evaluator<T, DAT>::partitions(std::size_t n) const
+{
+  return (n + partition_size - 1) / partition_size;
+}
+
+///
+/// \param[in] prg    program (individual/team) to be summarised
+/// \param[in] probes number of examples considered
+/// \return           a hash of the outputs of `prg` on `probes` examples
+///                   evenly spread over the dataset (an empty hash for teams
+///                   and streamed datasets)
+///
+/// The fitness computed by symbolic regression / classification evaluators
+/// only depends on the outputs of the program: programs producing the same
+/// outputs on the whole dataset have the same fitness (see
+/// `evaluator::fingerprint`).
+///
+/// \remark
+/// Negative zero and zero are hashed in the same way.
+///
+template<class T, class DAT>
+hash_t src_evaluator<T, DAT>::fingerprint(const T &prg, unsigned probes)
+{
+  if constexpr (!std::is_same_v<T, i_mep> || detail::is_streamed_v<DAT>)
+  {
+    (void)prg;
+    (void)probes;
+    return hash_t();
+  }
+  else
+  {
+    std::size_t n;
+    if constexpr (detail::is_columnar_v<DAT>)
+      n = dat_->size();
+    else
+      n = std::distance(std::begin(*dat_), std::end(*dat_));
+
+    if (!n || !probes)
+      return hash_t();
+
+    const std::size_t sup(std::min<std::size_t>(probes, n));
+
+    std::vector<std::byte> packed;
+    const auto append([&packed](const void *data, std::size_t len)
+    {
+      const auto *p(static_cast<const std::byte *>(data));
+      packed.insert(packed.end(), p, p + len);
+    });
+
+    src_interpreter<i_mep> intr(&prg);
+    for (std::size_t i(0); i < sup; ++i)
+    {
+      const auto row(i * n / sup);
+
+      value_t v;
+      if constexpr (detail::is_columnar_v<DAT>)
+        v = intr.run(*dat_, row);
+      else
+        v = intr.run(std::next(std::begin(*dat_), row)->input);
+
+      const auto type(static_cast<std::uint8_t>(v.index()));
+      append(&type, sizeof(type));
+
+      switch (v.index())
+      {
+      case d_int:
+        append(&std::get<D_INT>(v), sizeof(D_INT));
+        break;
+
+      case d_double:
+      {
+        const D_DOUBLE x(std::get<D_DOUBLE>(v) + 0.0);
+        append(&x, sizeof(x));
+        break;
+      }
+
+      case d_string:
+      {
+        const auto &str(std::get<D_STRING>(v));
+        const auto len(str.size());
+        append(&len, sizeof(len));
+        append(str.data(), len);
+        break;
+      }
+      }
+    }
+
+    return vita::hash::hash128(packed.data(), packed.size());
+  }
+}
+
 ///
 /// \param[in] d the training dataset
 ///
@@ -37,36 +239,380 @@ sum_of_errors_evaluator<T, ERRF, DAT>::sum_of_errors_evaluator(DAT &d)
 ///
 /// Sums the error reported by the error functor over a training set.
 ///
-/// \param[in] prg  program (individual/team) used for fitness evaluation
+/// \param[in] prg       program (individual/team) used for fitness
+///                      evaluation
+/// \param[in] step      consider just `1` example every `step`
+/// \param[in] max_error the evaluation can stop as soon as the average error
+///                      is proven to be greater than or equal to `max_error`
+///                      (see `race`)
+/// \return              the fitness (greater is better, max is `0`)
+///
+template<class T, class ERRF, class DAT>
+race_result sum_of_errors_evaluator<T, ERRF, DAT>::sum_of_errors_impl(
+  const T &prg, unsigned step, double max_error)
+{
+  if constexpr (detail::is_columnar_v<DAT>)
+    return {columnar_sum_of_errors(prg, step), true};
+  else if constexpr (detail::is_streamed_v<DAT>)
+    return {streamed_sum_of_errors(prg, step), true};
+  else
+  {
+    Expects(this->dat_->begin() != this->dat_->end());
+    Expects(!detail::classes(this->dat_));
+
+    if constexpr (detail::is_random_access_v<DAT>)
+      if (this->data_parallel_)
+        return {parallel_sum_of_errors(prg, step), true};
+
+    if constexpr (std::is_same_v<T, i_mep>
+                  && detail::is_batch_error_functor_v<ERRF, DAT>)
+      return batch_sum_of_errors(prg, step, max_error);
+
+    const auto examples(race_examples(step, max_error));
+    const ERRF err_fctr(prg);
+
+    double average_error(0.0), n(0.0);
+    for (auto it(std::begin(*this->dat_));
+         std::distance(it, std::end(*this->dat_)) >= step;
+         std::advance(it, step))
+    {
+      const auto err(err_fctr(*it));
+
+      // User specified examples could not support difficulty.
+      if constexpr (detail::has_difficulty_v<DAT>)
+        if (!this->read_only_ && !issmall(err))
+          ++it->difficulty;
+
+      average_error += (err - average_error) / ++n;
+
+      if (const auto lower(average_error * (n / examples));
+          lower >= max_error)
+        return {{static_cast<fitness_t::value_type>(-lower)}, false};
+    }
+
+    // Note that we take the average error: this way fast() and operator()
+    // outputs can be compared.
+    return {{static_cast<fitness_t::value_type>(-average_error)}, true};
+  }
+}
+
+///
+/// \param[in] step      consider just `1` example every `step`
+/// \param[in] max_error maximum average error (see `race`)
+/// \return              the number of examples considered by the evaluation
+///                      (`+inf` if there isn't a limit on the error)
+///
+/// Errors are non-negative: when the sum of the errors of the first `n`
+/// examples reaches `max_error * examples`, the final average error cannot be
+/// lower than `max_error`. This is checked via
+/// `average_error * (n / examples) >= max_error` (no overflow with huge
+/// errors and never true when `examples` is infinite).
+///
+template<class T, class ERRF, class DAT>
+double sum_of_errors_evaluator<T, ERRF, DAT>::race_examples(
+  unsigned step, double max_error) const
+{
+  if (std::isinf(max_error))
+    return std::numeric_limits<double>::infinity();
+
+  return static_cast<double>(std::distance(std::begin(*this->dat_),
+                                           std::end(*this->dat_)) / step);
+}
+
+///
+/// Same as `sum_of_errors_impl` but uses the batch interpreter.
+///
+/// \param[in] prg  program used for fitness evaluation
 /// \param[in] step consider just `1` example every `step`
 /// \return         the fitness (greater is better, max is `0`)
 ///
+/// Examples are processed in blocks: the output of the program for a whole
+/// block is computed by vita::batch_interpreter, then errors are accumulated
+/// in the same order of the scalar path (so the result is identical). The
+/// limit on the error (see `race`) is checked after every block.
+///
 template<class T, class ERRF, class DAT>
-fitness_t sum_of_errors_evaluator<T, ERRF, DAT>::sum_of_errors_impl(
-  const T &prg, unsigned step)
+race_result sum_of_errors_evaluator<T, ERRF, DAT>::batch_sum_of_errors(
+  const i_mep &prg, unsigned step, double max_error)
 {
-  Expects(this->dat_->begin() != this->dat_->end());
-  Expects(!detail::classes(this->dat_));
+  const auto examples(race_examples(step, max_error));
 
-  const ERRF err_fctr(prg);
+  using example_t = std::remove_reference_t<decltype(*this->dat_->begin())>;
+
+  // Examples are identified by address: the column cache requires a
+  // versioned dataset (see `dataframe::version()`).
+  batch_interpreter bi(&prg,
+                       detail::has_version_v<DAT> ? this->columns_.get()
+                                                  : nullptr);
+  std::vector<example_t *> block;
+  block.reserve(batch_interpreter::block_size);
 
   double average_error(0.0), n(0.0);
+  const auto flush([&]
+  {
+    bi.run(block, detail::version(*this->dat_));
+
+    for (std::size_t i(0); i < block.size(); ++i)
+    {
+      const auto err(ERRF::error(bi[i], *block[i]));
+
+      // User specified examples could not support difficulty.
+      if constexpr (detail::has_difficulty_v<DAT>)
+        if (!this->read_only_ && !issmall(err))
+          ++block[i]->difficulty;
+
+      average_error += (err - average_error) / ++n;
+    }
+
+    block.clear();
+  });
+
   for (auto it(std::begin(*this->dat_));
        std::distance(it, std::end(*this->dat_)) >= step;
        std::advance(it, step))
   {
-    const auto err(err_fctr(*it));
+    block.push_back(&*it);
 
-    // User specified examples could not support difficulty.
-    if constexpr (detail::has_difficulty_v<DAT>)
+    if (block.size() == batch_interpreter::block_size)
+    {
+      flush();
+
+      if (const auto lower(average_error * (n / examples));
+          lower >= max_error)
+        return {{static_cast<fitness_t::value_type>(-lower)}, false};
+    }
+  }
+
+  if (!block.empty())
+    flush();
+
+  return {{static_cast<fitness_t::value_type>(-average_error)}, true};
+}
+
+///
+/// Same as `sum_of_errors_impl` but partitions of the dataset are evaluated
+/// by different threads.
+///
+/// \param[in] prg  program used for fitness evaluation
+/// \param[in] step consider just `1` example every `step`
+/// \return         the fitness (greater is better, max is `0`)
+///
+/// Every partition computes its mean error (using the batch interpreter when
+/// possible) and records the examples whose difficulty must be increased.
+/// Difficulties are updated and partial means combined pairwise (see
+/// `detail::pairwise_mean`) after the parallel section, so there aren't
+/// shared writes.
+///
+template<class T, class ERRF, class DAT>
+fitness_t sum_of_errors_evaluator<T, ERRF, DAT>::parallel_sum_of_errors(
+  const T &prg, unsigned step)
+{
+  const auto first(std::begin(*this->dat_));
+  const std::size_t rows(std::distance(first, std::end(*this->dat_)) / step);
+  const auto n(this->partitions(rows));
+
+  std::vector<std::pair<double, double>> means(n);
+  std::vector<std::vector<std::size_t>> hard(n);
+
+  thread_pool::shared().parallel_for(n, [&](std::size_t p)
+  {
+    const auto begin(p * this->partition_size);
+    const auto end(std::min(rows, begin + this->partition_size));
+
+    double average_error(0.0), count(0.0);
+    const auto add([&](double err, std::size_t row)
+    {
       if (!issmall(err))
-        ++it->difficulty;
+        hard[p].push_back(row);
+
+      average_error += (err - average_error) / ++count;
+    });
+
+    if constexpr (std::is_same_v<T, i_mep>
+                  && detail::is_batch_error_functor_v<ERRF, DAT>)
+    {
+      batch_interpreter bi(&prg,
+                           detail::has_version_v<DAT> ? this->columns_.get()
+                                                      : nullptr);
+
+      for (auto b(begin); b < end; b += batch_interpreter::block_size)
+      {
+        const auto size(std::min(batch_interpreter::block_size, end - b));
+
+        std::vector<decltype(&*first)> block;
+        block.reserve(size);
+        for (std::size_t i(0); i < size; ++i)
+          block.push_back(&first[(b + i) * step]);
+
+        bi.run(block, detail::version(*this->dat_));
+
+        for (std::size_t i(0); i < size; ++i)
+          add(ERRF::error(bi[i], *block[i]), (b + i) * step);
+      }
+    }
+    else
+    {
+      const ERRF err_fctr(prg);
+
+      for (auto r(begin); r < end; ++r)
+        add(err_fctr(first[r * step]), r * step);
+    }
+
+    means[p] = {average_error, count};
+  });
+
+  // User specified examples could not support difficulty.
+  if constexpr (detail::has_difficulty_v<DAT>)
+    if (!this->read_only_)
+      for (const auto &rows_p : hard)
+        for (const auto r : rows_p)
+          ++first[r].difficulty;
+
+  const auto average_error(
+    detail::pairwise_mean(means.begin(), means.end()).first);
+  return {static_cast<fitness_t::value_type>(-average_error)};
+}
+
+///
+/// Same as `sum_of_errors_impl` but for a columnar dataframe.
+///
+/// \param[in] prg  program used for fitness evaluation
+/// \param[in] step consider just `1` example every `step`
+/// \return         the fitness (greater is better, max is `0`)
+///
+/// i_mep individuals are executed by vita::batch_interpreter directly over
+/// the columns. Errors are accumulated in the same order of the row-oriented
+/// paths (so the result is identical).
+///
+template<class T, class ERRF, class DAT>
+fitness_t sum_of_errors_evaluator<T, ERRF, DAT>::columnar_sum_of_errors(
+  const T &prg, unsigned step)
+{
+  const dataframe::columnar &d(*this->dat_);
+  Expects(!d.empty());
+  Expects(step);
+
+  // Error functors only look at the label of an example.
+  dataframe::example label;
+
+  double average_error(0.0), n(0.0);
+  const auto add([&](const value_t &v, std::size_t row)
+  {
+    label.output = d.output()[row];
+    const auto err(ERRF::error(v, label));
+
+    if (!this->read_only_ && !issmall(err))
+      ++this->dat_->difficulty[row];
 
     average_error += (err - average_error) / ++n;
+  });
+
+  // Same examples of the row-oriented path: `row` is used while there are
+  // at least `step` examples left.
+  const std::size_t rows(d.size() / step);
+
+  if constexpr (std::is_same_v<T, i_mep>)
+  {
+    batch_interpreter bi(&prg, this->columns_.get());
+
+    for (std::size_t b(0); b < rows; b += batch_interpreter::block_size)
+    {
+      const auto size(std::min(batch_interpreter::block_size, rows - b));
+      bi.run(d, b * step, size, step);
+
+      for (std::size_t i(0); i < size; ++i)
+        add(bi[i], (b + i) * step);
+    }
   }
+  else
+  {
+    src_interpreter<T> si(&prg);
+
+    for (std::size_t i(0); i < rows; ++i)
+      add(si.run(d, i * step), i * step);
+  }
+
+  return {static_cast<fitness_t::value_type>(-average_error)};
+}
+
+///
+/// Same as `sum_of_errors_impl` but for a dataset read block by block.
+///
+/// \param[in] prg  program used for fitness evaluation
+/// \param[in] step consider just `1` example every `step`
+/// \return         the fitness (greater is better, max is `0`)
+///
+/// Every block has its own error accumulator; the mean errors of the blocks
+/// are then combined (weighted by the number of examples). While a block is
+/// evaluated the next one is read by a background thread (see
+/// `streamed_dataframe`).
+///
+/// \remark
+/// - The size of the dataset isn't known in advance: the examples considered
+///   are the ones whose (global) index is a multiple of `step`.
+/// - Streamed examples are read-only: difficulties aren't updated.
+///
+template<class T, class ERRF, class DAT>
+fitness_t sum_of_errors_evaluator<T, ERRF, DAT>::streamed_sum_of_errors(
+  const T &prg, unsigned step)
+{
+  Expects(step);
+
+  using block_t = typename DAT::block_t;
+
+  double average_error(0.0), n(0.0);
+  std::size_t first(0);  // global index of the first example of a block
+
+  this->dat_->for_each_block([&](const block_t &block)
+  {
+    double block_error(0.0), block_n(0.0);
+    const auto add([&](double err)
+    {
+      block_error += (err - block_error) / ++block_n;
+    });
+
+    const std::size_t start((step - first % step) % step);
+
+    if constexpr (std::is_same_v<T, i_mep>
+                  && detail::is_batch_error_functor_v<ERRF, DAT>)
+    {
+      batch_interpreter bi(&prg);
+      std::vector<const typename block_t::value_type *> rows;
+      rows.reserve(batch_interpreter::block_size);
+
+      for (std::size_t i(start); i < block.size(); i += step)
+      {
+        rows.push_back(&block[i]);
+
+        if (rows.size() == batch_interpreter::block_size
+            || i + step >= block.size())
+        {
+          bi.run(rows);
+
+          for (std::size_t j(0); j < rows.size(); ++j)
+            add(ERRF::error(bi[j], *rows[j]));
+
+          rows.clear();
+        }
+      }
+    }
+    else
+    {
+      const ERRF err_fctr(prg);
+
+      for (std::size_t i(start); i < block.size(); i += step)
+        add(err_fctr(block[i]));
+    }
+
+    if (block_n > 0.0)
+    {
+      n += block_n;
+      average_error += (block_error - average_error) * block_n / n;
+    }
+
+    first += block.size();
+  });
 
-  // Note that we take the average error: this way fast() and operator()
-  // outputs can be compared.
   return {static_cast<fitness_t::value_type>(-average_error)};
 }
 
@@ -77,6 +623,30 @@ fitness_t sum_of_errors_evaluator<T, ERRF, DAT>::sum_of_errors_impl(
 template<class T, class ERRF, class DAT>
 fitness_t sum_of_errors_evaluator<T, ERRF, DAT>::operator()(const T &prg)
 {
+  return sum_of_errors_impl(prg, 1).fitness;
+}
+
+///
+/// \param[in] prg   program (individual/team) used for fitness evaluation
+/// \param[in] bound the fitness `prg` has to beat
+/// \return          the fitness of `prg` or an upper bound of the fitness
+///                  not greater than `bound` (see `evaluator::race`)
+///
+/// The evaluation stops as soon as the errors accumulated prove that the
+/// fitness of `prg` cannot be greater than `bound` (only for single-valued
+/// bounds and datasets whose size is known in advance; the data parallel
+/// mode always performs a complete evaluation).
+///
+/// \remark
+/// Difficulties are updated only for the examples actually evaluated.
+///
+template<class T, class ERRF, class DAT>
+race_result sum_of_errors_evaluator<T, ERRF, DAT>::race(
+  const T &prg, const fitness_t &bound)
+{
+  if (bound.size() == 1)
+    return sum_of_errors_impl(prg, 1, -bound[0]);
+
   return sum_of_errors_impl(prg, 1);
 }
 
@@ -90,8 +660,18 @@ fitness_t sum_of_errors_evaluator<T, ERRF, DAT>::operator()(const T &prg)
 template<class T, class ERRF, class DAT>
 fitness_t sum_of_errors_evaluator<T, ERRF, DAT>::fast(const T &prg)
 {
-  Expects(std::distance(this->dat_->begin(), this->dat_->end()) >= 100);
-  return sum_of_errors_impl(prg, 5);
+  // The size of a streamed dataset is unknown (counting would require a scan
+  // of the file).
+  if constexpr (detail::is_columnar_v<DAT>)
+  {
+    Expects(this->dat_->size() >= 100);
+  }
+  else if constexpr (!detail::is_streamed_v<DAT>)
+  {
+    Expects(std::distance(this->dat_->begin(), this->dat_->end()) >= 100);
+  }
+
+  return sum_of_errors_impl(prg, 5).fitness;
 }
 
 ///
@@ -125,7 +705,21 @@ mae_error_functor<T>::mae_error_functor(const T &prg) : agent_(prg)
 template<class T>
 double mae_error_functor<T>::operator()(const dataframe::example &example) const
 {
-  if (const auto model_value = agent_(example); has_value(model_value))
+  return error(agent_(example), example);
+}
+
+///
+/// \param[in] model_value output of the model/program on `example`
+/// \param[in] example     current training case
+/// \return                a measurement of the error of the model/program on
+///                        the given training case (value in the `[0;+inf[`
+///                        range)
+///
+template<class T>
+double mae_error_functor<T>::error(const value_t &model_value,
+                                   const dataframe::example &example)
+{
+  if (has_value(model_value))
     return std::fabs(lexical_cast<D_DOUBLE>(model_value)
                      - label_as<D_DOUBLE>(example));
 
@@ -151,10 +745,24 @@ rmae_error_functor<T>::rmae_error_functor(const T &prg) : agent_(prg)
 template<class T>
 double rmae_error_functor<T>::operator()(
   const dataframe::example &example) const
+{
+  return error(agent_(example), example);
+}
+
+///
+/// \param[in] model_value output of the model/program on `example`
+/// \param[in] example     current training case
+/// \return                measurement of the error of the model/program on
+///                        the current training case. The value returned is in
+///                        the `[0;200]` range
+///
+template<class T>
+double rmae_error_functor<T>::error(const value_t &model_value,
+                                    const dataframe::example &example)
 {
   double err(200.0);
 
-  if (const auto model_value = agent_(example); has_value(model_value))
+  if (has_value(model_value))
   {
     const auto approx(lexical_cast<D_DOUBLE>(model_value));
     const auto target(label_as<D_DOUBLE>(example));
@@ -197,7 +805,21 @@ mse_error_functor<T>::mse_error_functor(const T &prg) : agent_(prg)
 template<class T>
 double mse_error_functor<T>::operator()(const dataframe::example &example) const
 {
-  if (const auto model_value = agent_(example); has_value(model_value))
+  return error(agent_(example), example);
+}
+
+///
+/// \param[in] model_value output of the model/program on `example`
+/// \param[in] example     current training case
+/// \return                a measurement of the error of the model/program on
+///                        the current training case. The value returned is in
+///                        the `[0;+inf[` range
+///
+template<class T>
+double mse_error_functor<T>::error(const value_t &model_value,
+                                   const dataframe::example &example)
+{
+  if (has_value(model_value))
   {
     const double err(lexical_cast<D_DOUBLE>(model_value)
                      - label_as<D_DOUBLE>(example));
@@ -227,8 +849,20 @@ template<class T>
 double count_error_functor<T>::operator()(
   const dataframe::example &example) const
 {
-  const auto model_value(agent_(example));
+  return error(agent_(example), example);
+}
 
+///
+/// \param[in] model_value output of the model/program on `example`
+/// \param[in] example     current training case
+/// \return                a measurement of the error of the model/program on
+///                        the current training case. The value returned is in
+///                        the `[0;+inf[` range
+///
+template<class T>
+double count_error_functor<T>::error(const value_t &model_value,
+                                     const dataframe::example &example)
+{
   const bool err(!has_value(model_value)
                  || !issmall(lexical_cast<D_DOUBLE>(model_value)
                              - label_as<D_DOUBLE>(example)));
@@ -236,6 +870,76 @@ double count_error_functor<T>::operator()(
   return err ? 1.0 : 0.0;
 }
 
+///
+/// Sums a measure over the examples of the training set.
+///
+/// \param[in] lambda the lambda function of the program being evaluated
+/// \param[in] f      `f(lambda, example)` returns the contribution of
+///                   `example` and `true` if it's misclassified (its
+///                   difficulty is increased)
+/// \return           the sum of the contributions
+///
+/// In data parallel mode every partition works on its own copy of `lambda`
+/// (lambda functions have an internal state), difficulties are updated after
+/// the parallel section and partial sums are reduced via a pairwise sum.
+///
+template<class T>
+template<class L, class F>
+fitness_t::value_type classification_evaluator<T>::sum_over_examples(
+  const L &lambda, F f)
+{
+  auto &d(*this->dat_);
+
+  if (!this->data_parallel_)
+  {
+    fitness_t::value_type sum(0.0);
+
+    for (auto &example : d)
+    {
+      const auto [v, failed] = f(lambda, example);
+
+      sum += v;
+      if (failed && !this->read_only_)
+        ++example.difficulty;
+    }
+
+    return sum;
+  }
+
+  const auto rows(d.size());
+  const auto n(this->partitions(rows));
+
+  std::vector<fitness_t::value_type> sums(n);
+  std::vector<std::vector<std::size_t>> failed(n);
+
+  thread_pool::shared().parallel_for(n, [&](std::size_t p)
+  {
+    const L local(lambda);
+
+    const auto begin(p * this->partition_size);
+    const auto end(std::min(rows, begin + this->partition_size));
+
+    fitness_t::value_type sum(0.0);
+    for (auto i(begin); i < end; ++i)
+    {
+      const auto [v, f_i] = f(local, *std::next(d.begin(), i));
+
+      sum += v;
+      if (f_i)
+        failed[p].push_back(i);
+    }
+
+    sums[p] = sum;
+  });
+
+  if (!this->read_only_)
+    for (const auto &rows_p : failed)
+      for (const auto i : rows_p)
+        ++std::next(d.begin(), i)->difficulty;
+
+  return pairwise_sum(sums.begin(), sums.end());
+}
+
 ///
 /// \param[in] d      current dataset
 /// \param[in] x_slot basic parameter for the Slotted Dynamic Class Boundary
@@ -257,13 +961,13 @@ fitness_t dyn_slot_evaluator<T>::operator()(const T &ind)
 {
   basic_dyn_slot_lambda_f<T, false, false> lambda(ind, *this->dat_, x_slot_);
 
-  fitness_t::value_type err(0.0);
-  for (auto &example : *this->dat_)
-    if (lambda.tag(example).label != label(example))
+  const fitness_t::value_type err(this->sum_over_examples(
+    lambda,
+    [](const auto &l, const dataframe::example &example)
     {
-      ++err;
-      ++example.difficulty;
-    }
+      const bool failed(l.tag(example).label != label(example));
+      return std::pair(failed ? 1.0 : 0.0, failed);
+    }));
 
   return {-err};
 
@@ -302,28 +1006,27 @@ fitness_t gaussian_evaluator<T>::operator()(const T &ind)
 
   basic_gaussian_lambda_f<T, false, false> lambda(ind, *this->dat_);
 
-  fitness_t::value_type d(0.0);
-  for (auto &example : *this->dat_)
-    if (const auto res = lambda.tag(example); res.label == label(example))
-    {
-      const auto scale(static_cast<fitness_t::value_type>(this->dat_->classes()
-                                                          - 1));
-      // Note:
-      // * `(1.0 - res.sureness)` is the sum of the errors;
-      // * `(res.sureness - 1.0)` is the opposite (standardized fitness);
-      // * `(res.sureness - 1.0) / scale` is the opposite of the average error.
-      d += (res.sureness - 1.0) / scale;
-    }
-    else
+  const auto scale(static_cast<fitness_t::value_type>(this->dat_->classes()
+                                                      - 1));
+
+  const fitness_t::value_type d(this->sum_over_examples(
+    lambda,
+    [scale](const auto &l, const dataframe::example &example)
     {
+      if (const auto res = l.tag(example); res.label == label(example))
+        // Note:
+        // * `(1.0 - res.sureness)` is the sum of the errors;
+        // * `(res.sureness - 1.0)` is the opposite (standardized fitness);
+        // * `(res.sureness - 1.0) / scale` is the opposite of the average
+        //   error.
+        return std::pair((res.sureness - 1.0) / scale, false);
+
       // Note:
       // * the maximum single class error is 1.0;
       // * the maximum average class error is `1.0 / dat_->classes()`;
       // So -1.0 is like to say that we have a complete failure.
-      d -= 1.0;
-
-      ++example.difficulty;
-    }
+      return std::pair(-1.0, true);
+    }));
 
   return {d};
 }
@@ -350,16 +1053,15 @@ fitness_t binary_evaluator<T>::operator()(const T &ind)
   Expects(this->dat_->classes() == 2);
 
   basic_binary_lambda_f<T, false, false> agent(ind, *this->dat_);
-  fitness_t::value_type err(0.0);
 
-  for (auto &example : *this->dat_)
-    if (label(example) != agent.tag(example).label)
+  const fitness_t::value_type err(this->sum_over_examples(
+    agent,
+    [](const auto &a, const dataframe::example &example)
     {
-      ++example.difficulty;
-      ++err;
-
       // err += std::fabs(val);
-    }
+      const bool failed(label(example) != a.tag(example).label);
+      return std::pair(failed ? 1.0 : 0.0, failed);
+    }));
 
   return {-err};
 }
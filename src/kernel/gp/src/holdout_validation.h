@@ -35,6 +35,9 @@ public:
 
   void init(unsigned) override;
 
+  // Datasets are partitioned only once (by `init(0)`): runs can share them.
+  bool is_concurrent() const override { return true; }
+
 private:
   dataframe &training_;
   dataframe &validation_;
@@ -13,7 +13,12 @@
 #if !defined(VITA_SRC_INTERPRETER_H)
 #define      VITA_SRC_INTERPRETER_H
 
+#include <memory>
+
 #include "kernel/gp/mep/interpreter.h"
+#include "kernel/gp/src/bytecode.h"
+#include "kernel/gp/src/dataframe.h"
+#include "kernel/gp/src/native_code.h"
 
 namespace vita
 {
@@ -28,15 +33,27 @@ using number = D_DOUBLE;
 /// This class extends vita::interpreter to simply manage input variables.
 /// For further details see vita::variable class.
 ///
+/// i_mep individuals are compiled (see vita::bytecode) the first time they're
+/// run and the compiled code is reused for every subsequent example. They can
+/// also be compiled to machine code (see `compile_native`).
+///
 template<class T>
 class src_interpreter : public interpreter<T>
 {
 public:
   explicit src_interpreter(const T *prg) : interpreter<T>(prg),
-                                           example_(nullptr)
+                                           example_(nullptr), data_(nullptr),
+                                           row_(0), code_(), registers_(),
+                                           native_()
   {}
 
   value_t run(const std::vector<value_t> &);
+  value_t run(const dataframe::columnar &, std::size_t);
+
+  bool compile_native(const std::filesystem::path &
+                      = native_code::default_dir());
+  void share_native(const src_interpreter &);
+  [[nodiscard]] bool native() const;
 
   [[nodiscard]] value_t fetch_var(unsigned) final;
 
@@ -51,6 +68,21 @@ private:
   using interpreter<T>::run;
 
   const std::vector<value_t> *example_;
+
+  // Used when examples come from a columnar dataframe.
+  const dataframe::columnar *data_;
+  std::size_t row_;
+
+  // Compiled program (used only for i_mep individuals). Copies of the
+  // interpreter share it.
+  mutable std::shared_ptr<const bytecode> code_;
+  bytecode::registers registers_;
+
+  // Machine code version of the program (optional, only for i_mep
+  // individuals).
+  std::shared_ptr<const native_code> native_;
+
+  [[nodiscard]] const bytecode &code() const;
 };
 
 template<class T> value_t run(const T &, const std::vector<value_t> &);
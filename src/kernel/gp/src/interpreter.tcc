@@ -26,10 +26,102 @@
 template<class T>
 value_t src_interpreter<T>::run(const std::vector<value_t> &ex)
 {
+  if constexpr (std::is_same_v<T, i_mep>)
+  {
+    if (native_)
+      if (const auto v = (*native_)(ex))
+        return *v;
+
+    return code().run(registers_, ex);
+  }
+
   example_ = &ex;
+  data_ = nullptr;
+  return this->run();
+}
+
+///
+/// Calculates the output of a program (individual) given a specific example
+/// of a columnar dataframe.
+///
+/// \param[in] d   a columnar dataframe
+/// \param[in] row index of the example
+/// \return        the output value of the src_interpreter
+///
+template<class T>
+value_t src_interpreter<T>::run(const dataframe::columnar &d, std::size_t row)
+{
+  Expects(row < d.size());
+
+  if constexpr (std::is_same_v<T, i_mep>)
+  {
+    if (native_)
+      if (const auto v = (*native_)(d, row))
+        return *v;
+
+    return code().run(registers_, d, row);
+  }
+
+  data_ = &d;
+  row_ = row;
   return this->run();
 }
 
+///
+/// \return the compiled version of the program
+///
+/// The program is compiled at the first call.
+///
+template<class T>
+const bytecode &src_interpreter<T>::code() const
+{
+  if (!code_)
+    code_ = std::make_shared<const bytecode>(this->program());
+
+  return *code_;
+}
+
+///
+/// Compiles the program to machine code.
+///
+/// \param[in] dir directory of the cached shared objects
+/// \return        `true` if the machine code is available and will be used
+///
+/// When the program isn't supported or a compiler isn't available the
+/// interpreter keeps using the bytecode (see vita::native_code for details).
+/// Examples whose values aren't finite real numbers are always processed by
+/// the bytecode.
+///
+template<class T>
+bool src_interpreter<T>::compile_native(const std::filesystem::path &dir)
+{
+  if constexpr (std::is_same_v<T, i_mep>)
+    native_ = native_code::build(this->program(), dir);
+
+  return native();
+}
+
+///
+/// Uses the machine code of another interpreter.
+///
+/// \param[in] si an interpreter for the same program
+///
+template<class T>
+void src_interpreter<T>::share_native(const src_interpreter &si)
+{
+  Expects(this->program() == si.program());
+  native_ = si.native_;
+}
+
+///
+/// \return `true` if the program is executed as machine code
+///
+template<class T>
+bool src_interpreter<T>::native() const
+{
+  return native_ != nullptr;
+}
+
 ///
 /// Used by the vita::variable class to retrieve the value of a variable.
 ///
@@ -39,6 +131,12 @@ value_t src_interpreter<T>::run(const std::vector<value_t> &ex)
 template<class T>
 value_t src_interpreter<T>::fetch_var(unsigned i)
 {
+  if (data_)
+  {
+    Expects(i < data_->variables());
+    return data_->input(i)[row_];
+  }
+
   Expects(i < example_->size());
   return (*example_)[i];
 }
@@ -141,6 +141,9 @@ public:
 
   bool is_valid() const final;
 
+  bool compile_native(const std::filesystem::path &
+                      = native_code::default_dir());
+
   // *** Serialization ***
   static const std::string SERIALIZE_ID;
   bool save(std::ostream &) const final;
@@ -231,6 +234,9 @@ public:
 
   bool is_valid() const final;
 
+  bool compile_native(const std::filesystem::path &
+                      = native_code::default_dir());
+
   double training_accuracy() const;
 
   // *** Serialization ***
@@ -283,6 +289,9 @@ public:
 
   bool is_valid() const final;
 
+  bool compile_native(const std::filesystem::path &
+                      = native_code::default_dir());
+
   // *** Serialization ***
   static const std::string SERIALIZE_ID;
   bool save(std::ostream &) const final;
@@ -324,6 +333,9 @@ public:
 
   bool is_valid() const final;
 
+  bool compile_native(const std::filesystem::path &
+                      = native_code::default_dir());
+
   // *** Serialization ***
   static const std::string SERIALIZE_ID;
   bool save(std::ostream &) const final;
@@ -360,6 +372,9 @@ public:
 
   bool is_valid() const final;
 
+  bool compile_native(const std::filesystem::path &
+                      = native_code::default_dir());
+
   static const std::string SERIALIZE_ID;
 
 private:
@@ -152,6 +152,23 @@ bool basic_reg_lambda_f<T, S>::is_valid() const
   return detail::reg_lambda_f_storage<T, S>::is_valid();
 }
 
+///
+/// Compiles the program to machine code.
+///
+/// \param[in] dir directory of the cached shared objects
+/// \return        `true` if the machine code is available (for a team, for
+///                every member of the team)
+///
+/// Programs which cannot be compiled are still interpreted (see
+/// vita::native_code).
+///
+template<class T, bool S>
+bool basic_reg_lambda_f<T, S>::compile_native(
+  const std::filesystem::path &dir)
+{
+  return detail::reg_lambda_f_storage<T, S>::compile_native(dir);
+}
+
 ///
 /// Saves the object on persistent storage.
 ///
@@ -437,6 +454,21 @@ bool basic_dyn_slot_lambda_f<T, S, N>::is_valid() const
   return true;
 }
 
+///
+/// Compiles the underlying program to machine code.
+///
+/// \param[in] dir directory of the cached shared objects
+/// \return        `true` if the machine code is available
+///
+/// \see basic_reg_lambda_f::compile_native
+///
+template<class T, bool S, bool N>
+bool basic_dyn_slot_lambda_f<T, S, N>::compile_native(
+  const std::filesystem::path &dir)
+{
+  return lambda_.compile_native(dir);
+}
+
 ///
 /// \param[in] ind individual "to be transformed" into a lambda function
 /// \param[in] d   the training set
@@ -604,6 +636,21 @@ bool basic_gaussian_lambda_f<T, S, N>::is_valid() const
   return true;
 }
 
+///
+/// Compiles the underlying program to machine code.
+///
+/// \param[in] dir directory of the cached shared objects
+/// \return        `true` if the machine code is available
+///
+/// \see basic_reg_lambda_f::compile_native
+///
+template<class T, bool S, bool N>
+bool basic_gaussian_lambda_f<T, S, N>::compile_native(
+  const std::filesystem::path &dir)
+{
+  return lambda_.compile_native(dir);
+}
+
 ///
 /// \param[in] ind individual "to be transformed" into a lambda function
 /// \param[in] d   the training set
@@ -663,6 +710,21 @@ bool basic_binary_lambda_f<T, S, N>::is_valid() const
   return true;
 }
 
+///
+/// Compiles the underlying program to machine code.
+///
+/// \param[in] dir directory of the cached shared objects
+/// \return        `true` if the machine code is available
+///
+/// \see basic_reg_lambda_f::compile_native
+///
+template<class T, bool S, bool N>
+bool basic_binary_lambda_f<T, S, N>::compile_native(
+  const std::filesystem::path &dir)
+{
+  return lambda_.compile_native(dir);
+}
+
 ///
 /// Saves the lambda on persistent storage.
 ///
@@ -823,6 +885,27 @@ bool team_class_lambda_f<T, S, N, L, C>::is_valid() const
   return classes_ > 1;
 }
 
+///
+/// Compiles the programs of the team to machine code.
+///
+/// \param[in] dir directory of the cached shared objects
+/// \return        `true` if the machine code is available for every member
+///                of the team
+///
+/// \see basic_reg_lambda_f::compile_native
+///
+template<class T, bool S, bool N, template<class, bool, bool> class L,
+         team_composition C>
+bool team_class_lambda_f<T, S, N, L, C>::compile_native(
+  const std::filesystem::path &dir)
+{
+  bool ret(true);
+  for (auto &lambda : team_)
+    ret = lambda.compile_native(dir) && ret;
+
+  return ret;
+}
+
 namespace serialize
 {
 
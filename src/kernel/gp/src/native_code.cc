@@ -0,0 +1,374 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2024 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#  include <dlfcn.h>
+#  include <unistd.h>
+#  define VITA_HAS_DLOPEN
+#endif
+
+#include "kernel/gp/src/native_code.h"
+#include "kernel/gp/src/primitive/real.h"
+#include "kernel/gp/src/variable.h"
+
+namespace vita
+{
+
+namespace
+{
+
+// Name of the scoring function inside the shared object.
+const char k_entry[] = "vita_native_model";
+
+// Non-variable terminals are evaluated once, at compile time.
+class constant_params : public symbol_params
+{
+public:
+  explicit constant_params(terminal_param_t p) : par_(p) {}
+
+  value_t fetch_arg(unsigned) final { return {}; }
+  value_t fetch_opaque_arg(unsigned) final { return {}; }
+  terminal_param_t fetch_param() const final { return par_; }
+
+private:
+  terminal_param_t par_;
+};
+
+// Number of leading arguments of `f` that must contain a value (the other
+// ones are the branches of a conditional function). `0` means that `f` isn't
+// supported.
+unsigned strict_args(const symbol &f)
+{
+  if (!dynamic_cast<const real::vector_kernel *>(&f))
+    return 0;
+
+  if (dynamic_cast<const real::ifz *>(&f))
+    return 1;
+  if (dynamic_cast<const real::ife *>(&f) || dynamic_cast<const real::ifl *>(&f))
+    return 2;
+  if (dynamic_cast<const real::ifb *>(&f))
+    return 3;
+
+  return f.arity();
+}
+
+// Exact representation of a real constant.
+std::string literal(double v)
+{
+  std::ostringstream ss;
+  ss << std::hexfloat << v;
+  return ss.str();
+}
+
+// Translates the active code of `prg` to C++. Returns an empty string for
+// unsupported programs.
+std::string generate(const i_mep &prg, std::vector<unsigned> &vars)
+{
+  std::vector<locus> active;
+  for (auto i(prg.begin()); i != prg.end(); ++i)
+    active.push_back(i.locus());
+
+  // Arguments have greater loci than the genes using them.
+  std::reverse(active.begin(), active.end());
+
+  std::map<locus, std::string> reg;
+  std::ostringstream body;
+  std::size_t inputs(0);
+  vars.clear();
+
+  for (const auto &l : active)
+  {
+    const gene &g(prg[l]);
+    std::string expr;
+
+    if (const auto *v = dynamic_cast<const variable *>(g.sym))
+    {
+      expr = "x[" + std::to_string(v->var_id()) + "]";
+
+      vars.push_back(v->var_id());
+      inputs = std::max<std::size_t>(inputs, v->var_id() + 1);
+    }
+    else if (g.sym->terminal())
+    {
+      constant_params p(g.par);
+      const value_t val(g.sym->eval(p));
+
+      const auto *d(std::get_if<D_DOUBLE>(&val));
+      if (!d || !std::isfinite(*d))
+        return {};
+
+      expr = literal(*d);
+    }
+    else
+    {
+      const auto strict(strict_args(*g.sym));
+      if (!strict)
+        return {};
+
+      expr = function::cast(g.sym)->display(symbol::cpp_format);
+
+      std::string guard;
+      for (unsigned i(0); i < g.sym->arity(); ++i)
+      {
+        const auto &arg(reg.at(g.locus_of_argument(i)));
+
+        expr = replace_all(expr, "%%" + std::to_string(i + 1) + "%%", arg);
+
+        if (i < strict)
+          guard += (guard.empty() ? "std::isnan(" : " || std::isnan(")
+                   + arg + ")";
+      }
+
+      expr = guard + " ? empty : fin(" + expr + ")";
+    }
+
+    const auto r("r" + std::to_string(reg.size()));
+    body << "    const double " << r << " = " << expr << ";\n";
+    reg[l] = r;
+  }
+
+  std::sort(vars.begin(), vars.end());
+  vars.erase(std::unique(vars.begin(), vars.end()), vars.end());
+
+  std::ostringstream ss;
+  ss << "// Generated by Vita (see vita::native_code).\n"
+        "#include <cmath>\n"
+        "#include <cstddef>\n"
+        "#include <limits>\n"
+        "#include <math.h>\n\n"
+        "namespace\n{\n"
+        "constexpr double empty = std::numeric_limits<double>::quiet_NaN();\n"
+        "inline double fin(double v) { return std::isfinite(v) ? v : empty; }"
+        "\n}\n\n"
+        "extern \"C\" void " << k_entry
+     << "(const double *x, std::size_t n, double *out)\n"
+        "{\n"
+        "  for (std::size_t i = 0; i < n; ++i, x += " << inputs << ")\n"
+        "  {\n"
+     << body.str()
+     << "    out[i] = " << reg.at(prg.best()) << ";\n"
+        "  }\n"
+        "}\n";
+
+  return ss.str();
+}
+
+}  // unnamed namespace
+
+///
+/// \param[in] handle handle of the shared object
+/// \param[in] f      the scoring function
+/// \param[in] vars   indices of the variables used by the program
+///
+native_code::native_code(void *handle, function_t *f,
+                         std::vector<unsigned> vars)
+  : handle_(handle), f_(f), vars_(std::move(vars)),
+    inputs_(vars_.empty() ? 0 : vars_.back() + 1)
+{
+  Expects(handle_);
+  Expects(f_);
+}
+
+///
+/// Unloads the shared object.
+///
+native_code::~native_code()
+{
+#if defined(VITA_HAS_DLOPEN)
+  dlclose(handle_);
+#endif
+}
+
+///
+/// Compiles and loads a program.
+///
+/// \param[in] prg a program
+/// \param[in] dir directory of the cached shared objects
+/// \return        the compiled program (`nullptr` if the program isn't
+///                supported or if a compiler isn't available)
+///
+/// A shared object built for the same program is reused. Besides the
+/// signature, the name of the file contains a hash of the source code:
+/// programs of distinct problems (e.g. with different variables) never share
+/// a file.
+///
+std::shared_ptr<const native_code> native_code::build(
+  const i_mep &prg, const std::filesystem::path &dir)
+{
+#if defined(VITA_HAS_DLOPEN)
+  std::vector<unsigned> vars;
+  const auto src(generate(prg, vars));
+  if (src.empty())
+    return nullptr;
+
+  std::error_code ec;
+  std::filesystem::create_directories(dir, ec);
+  if (ec)
+    return nullptr;
+
+  std::ostringstream name;
+  const auto sig(prg.signature());
+  name << "vita_" << std::hex << std::setfill('0')
+       << std::setw(16) << sig.data[0] << std::setw(16) << sig.data[1]
+       << '_' << std::setw(16) << std::hash<std::string>{}(src);
+
+  const auto so(dir / (name.str() + ".so"));
+
+  if (!std::filesystem::exists(so))
+  {
+    // Many threads / processes could build the same program at the same
+    // time: the shared object is built with a unique name and then renamed.
+    std::ostringstream tmp_name;
+    tmp_name << name.str() << '.' << ::getpid() << '.'
+             << std::hash<std::thread::id>{}(std::this_thread::get_id());
+    const auto tmp_cc(dir / (tmp_name.str() + ".cc"));
+    const auto tmp_so(dir / (tmp_name.str() + ".so"));
+
+    if (!(std::ofstream(tmp_cc) << src))
+      return nullptr;
+
+    const char *cxx(std::getenv("VITA_CXX"));
+    if (!cxx || !*cxx)
+      cxx = std::getenv("CXX");
+    if (!cxx || !*cxx)
+      cxx = "c++";
+
+    const std::string cmd(std::string(cxx)
+                          + " -std=c++17 -O2 -shared -fPIC -o \""
+                          + tmp_so.string() + "\" \"" + tmp_cc.string()
+                          + "\" > /dev/null 2>&1");
+
+    const bool ok(std::system(cmd.c_str()) == 0);
+
+    if (ok)
+    {
+      std::filesystem::rename(tmp_so, so, ec);
+      std::filesystem::rename(tmp_cc, dir / (name.str() + ".cc"), ec);
+    }
+
+    std::filesystem::remove(tmp_so, ec);
+    std::filesystem::remove(tmp_cc, ec);
+
+    if (!ok)
+      return nullptr;
+  }
+
+  void *handle(dlopen(so.c_str(), RTLD_NOW | RTLD_LOCAL));
+  if (!handle)
+    return nullptr;
+
+  auto *f(reinterpret_cast<function_t *>(dlsym(handle, k_entry)));
+  if (!f)
+  {
+    dlclose(handle);
+    return nullptr;
+  }
+
+  return std::shared_ptr<const native_code>(
+    new native_code(handle, f, std::move(vars)));
+#else
+  (void)prg;
+  (void)dir;
+  return nullptr;
+#endif
+}
+
+///
+/// \param[in] prg a program
+/// \return        the C++ source code of the scoring function (an empty
+///                string if the program isn't supported)
+///
+/// The function has the signature
+///
+///     extern "C" void vita_native_model(const double *x, std::size_t n,
+///                                       double *out);
+///
+/// and scores the `n` rows of `x` (see `run`).
+///
+std::string native_code::source(const i_mep &prg)
+{
+  std::vector<unsigned> vars;
+  return generate(prg, vars);
+}
+
+///
+/// \return the default directory of the cached shared objects
+///
+std::filesystem::path native_code::default_dir()
+{
+  return std::filesystem::temp_directory_path() / "vita_native";
+}
+
+///
+/// Scores a block of examples.
+///
+/// \param[in]  x   row-major matrix of input values (`n` rows of `inputs()`
+///                 values)
+/// \param[in]  n   number of examples
+/// \param[out] out `n` output values (NaN stands for the empty value)
+///
+void native_code::run(const double *x, std::size_t n, double *out) const
+{
+  f_(x, n, out);
+}
+
+///
+/// \param[in] ex a vector of values for the problem's variables
+/// \return       the output value of the program (an empty `optional` when
+///               `ex` contains values which aren't finite real numbers)
+///
+std::optional<value_t> native_code::operator()(
+  const std::vector<value_t> &ex) const
+{
+  return run_one([&ex](unsigned i)
+                 {
+                   Expects(i < ex.size());
+                   return ex[i];
+                 });
+}
+
+///
+/// \param[in] d   a columnar dataframe
+/// \param[in] row index of an example
+/// \return        the output value of the program for the `row`-th example
+///                (an empty `optional` when the example contains values which
+///                aren't finite real numbers)
+///
+std::optional<value_t> native_code::operator()(const dataframe::columnar &d,
+                                               std::size_t row) const
+{
+  Expects(row < d.size());
+
+  return run_one([&d, row](unsigned i)
+                 {
+                   Expects(i < d.variables());
+                   return d.input(i)[row];
+                 });
+}
+
+///
+/// \return number of values of an input row (see `run`)
+///
+std::size_t native_code::inputs() const
+{
+  return inputs_;
+}
+
+}  // namespace vita
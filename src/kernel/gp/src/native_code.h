@@ -0,0 +1,128 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2024 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#if !defined(VITA_SRC_NATIVE_CODE_H)
+#define      VITA_SRC_NATIVE_CODE_H
+
+#include <cmath>
+#include <filesystem>
+#include <memory>
+#include <optional>
+
+#include "kernel/gp/mep/i_mep.h"
+#include "kernel/gp/src/dataframe.h"
+
+namespace vita
+{
+
+///
+/// An i_mep individual compiled to machine code.
+///
+/// The active code is translated to a C++ function (the expressions of the
+/// functions are the ones printed by `out::cpp_language`, see
+/// `symbol::cpp_format`), compiled with the system compiler into a shared
+/// object and loaded at run-time. Shared objects are cached on disk, keyed by
+/// the signature of the individual, so a model is compiled just once.
+///
+/// The compiler is the one specified by the `VITA_CXX` or `CXX` environment
+/// variables (`c++` if both are unset).
+///
+/// Only real-valued programs are supported: every active function must be a
+/// real-valued primitive (see vita::real::vector_kernel) and every terminal a
+/// variable or a real constant. Empty values are represented by NaN.
+///
+/// \remark
+/// Results follow the exported C++ code and can differ from the ones of the
+/// interpreter in the last bits (e.g. the interpreter uses two different
+/// formulas for the sigmoid function).
+///
+/// \warning
+/// Requires a POSIX system (`dlopen`). Elsewhere `build` always fails.
+///
+class native_code
+{
+public:
+  ~native_code();
+
+  native_code(const native_code &) = delete;
+  native_code &operator=(const native_code &) = delete;
+
+  [[nodiscard]] static std::shared_ptr<const native_code> build(
+    const i_mep &, const std::filesystem::path & = default_dir());
+
+  [[nodiscard]] static std::string source(const i_mep &);
+  [[nodiscard]] static std::filesystem::path default_dir();
+
+  [[nodiscard]] std::optional<value_t> operator()(
+    const std::vector<value_t> &) const;
+  [[nodiscard]] std::optional<value_t> operator()(
+    const dataframe::columnar &, std::size_t) const;
+
+  void run(const double *, std::size_t, double *) const;
+
+  [[nodiscard]] std::size_t inputs() const;
+
+private:
+  using function_t = void (const double *, std::size_t, double *);
+
+  native_code(void *, function_t *, std::vector<unsigned>);
+
+  template<class F> [[nodiscard]] std::optional<value_t> run_one(F) const;
+
+  // Handle of the shared object and the scoring function.
+  void *handle_;
+  function_t *f_;
+
+  // Indices of the variables used by the program.
+  std::vector<unsigned> vars_;
+
+  // Number of values of an input row (maximum variable index + 1).
+  std::size_t inputs_;
+};
+
+///
+/// Scores a single example.
+///
+/// \param[in] var a function returning the value of an input variable given
+///                its index
+/// \return        the output of the program or an empty `optional` if some
+///                variable doesn't contain a finite real number (the example
+///                must be scored by the interpreter)
+///
+template<class F>
+std::optional<value_t> native_code::run_one(F var) const
+{
+  thread_local std::vector<double> in;
+  in.assign(inputs_, 0.0);
+
+  for (const auto i : vars_)
+  {
+    const value_t v(var(i));
+    const auto *d(std::get_if<D_DOUBLE>(&v));
+
+    if (!d || !std::isfinite(*d))
+      return std::nullopt;
+
+    in[i] = *d;
+  }
+
+  double out;
+  f_(in.data(), 1, &out);
+
+  if (std::isnan(out))
+    return value_t();
+  return value_t(out);
+}
+
+}  // namespace vita
+
+#endif  // include guard
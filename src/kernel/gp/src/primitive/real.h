@@ -18,6 +18,7 @@
 #include "kernel/gp/function.h"
 #include "kernel/gp/mep/interpreter.h"
 #include "kernel/gp/src/primitive/comp_penalty.h"
+#include "kernel/gp/src/primitive/real_kernel.h"
 #include "kernel/gp/terminal.h"
 #include "kernel/random.h"
 #include "utility/utility.h"
@@ -51,6 +52,24 @@ inline base_t base(const value_t &v)
   return std::get<base_t>(v);
 }
 
+///
+/// \return the empty value of the scalar kernels (see
+///         `vector_kernel::eval_scalar`)
+///
+inline base_t empty()
+{
+  return std::numeric_limits<base_t>::quiet_NaN();
+}
+
+///
+/// \param[in] x a real number
+/// \return      `x` if it's a finite number, the empty value otherwise
+///
+inline base_t finite_or_nan(base_t x)
+{
+  return std::isfinite(x) ? x : empty();
+}
+
 ///
 /// Ephemeral random constant.
 ///
@@ -123,7 +142,7 @@ private:
 ///
 /// The absolute value of a real number.
 ///
-class abs : public function
+class abs : public function, public vector_kernel
 {
 public:
   explicit abs(const cvect &c = {0}) : function("FABS", c[0], {c[0]})
@@ -145,12 +164,23 @@ public:
     const auto a(args[0]);
     return has_value(a) ? std::fabs(base(a)) : a;
   }
+
+  void eval_columns(const const_column args[], column out,
+                    std::size_t n) const final
+  {
+    kernel::abs(args[0], out, n);
+  }
+
+  base_t eval_scalar(const base_t a[]) const final
+  {
+    return std::fabs(a[0]);
+  }
 };
 
 ///
 /// Sum of two real numbers.
 ///
-class add : public function
+class add : public function, public vector_kernel
 {
 public:
   explicit add(const cvect &c = {0}) : function("FADD", c[0], {c[0], c[0]}) {}
@@ -175,6 +205,17 @@ public:
 
     return ret;
   }
+
+  void eval_columns(const const_column args[], column out,
+                    std::size_t n) const final
+  {
+    kernel::add(args[0], args[1], out, n);
+  }
+
+  base_t eval_scalar(const base_t a[]) const final
+  {
+    return finite_or_nan(a[0] + a[1]);
+  }
 };
 
 ///
@@ -186,7 +227,7 @@ public:
 /// protected or unprotected division. Further, the AQ operator is
 /// differentiable.
 ///
-class aq : public function
+class aq : public function, public vector_kernel
 {
 public:
   explicit aq(const cvect &c = {0}) : function("AQ", c[0], {c[0], c[0]})
@@ -216,12 +257,23 @@ public:
 
     return ret;
   }
+
+  void eval_columns(const const_column args[], column out,
+                    std::size_t n) const final
+  {
+    kernel::aq(args[0], args[1], out, n);
+  }
+
+  base_t eval_scalar(const base_t a[]) const final
+  {
+    return finite_or_nan(a[0] / std::sqrt(1.0 + a[1] * a[1]));
+  }
 };
 
 ///
 /// `cos()` of a real number.
 ///
-class cos : public function
+class cos : public function, public vector_kernel
 {
 public:
   explicit cos(const cvect &c = {0}) : function("FCOS", c[0], {c[0]})
@@ -244,12 +296,23 @@ public:
 
     return std::cos(base(a));
   }
+
+  void eval_columns(const const_column args[], column out,
+                    std::size_t n) const final
+  {
+    kernel::cos(args[0], out, n);
+  }
+
+  base_t eval_scalar(const base_t a[]) const final
+  {
+    return std::cos(a[0]);
+  }
 };
 
 ///
 /// Unprotected division (UPD) between two real numbers.
 ///
-class div : public function
+class div : public function, public vector_kernel
 {
 public:
   explicit div(const cvect &c = {0}) : function("FDIV", c[0], {c[0], c[0]})
@@ -273,6 +336,17 @@ public:
 
     return ret;
   }
+
+  void eval_columns(const const_column args[], column out,
+                    std::size_t n) const final
+  {
+    kernel::div(args[0], args[1], out, n);
+  }
+
+  base_t eval_scalar(const base_t a[]) const final
+  {
+    return finite_or_nan(a[0] / a[1]);
+  }
 };
 
 ///
@@ -311,7 +385,7 @@ public:
 ///
 /// Quotient of the division between two real numbers.
 ///
-class idiv : public function
+class idiv : public function, public vector_kernel
 {
 public:
   explicit idiv(const cvect &c = {0}) : function("FIDIV", c[0], {c[0], c[0]})
@@ -341,6 +415,17 @@ public:
 
     return ret;
   }
+
+  void eval_columns(const const_column args[], column out,
+                    std::size_t n) const final
+  {
+    kernel::idiv(args[0], args[1], out, n);
+  }
+
+  base_t eval_scalar(const base_t a[]) const final
+  {
+    return finite_or_nan(std::floor(a[0] / a[1]));
+  }
 };
 
 ///
@@ -348,7 +433,7 @@ public:
 ///
 /// \warning Requires five input arguments.
 ///
-class ifb : public function
+class ifb : public function, public vector_kernel
 {
 public:
   explicit ifb(const cvect &c = {0, 0})
@@ -390,12 +475,29 @@ public:
     else
       return args[3];
   }
+
+  void eval_columns(const const_column args[], column out,
+                    std::size_t n) const final
+  {
+    kernel::ifb(args, out, n);
+  }
+
+  base_t eval_scalar(const base_t a[]) const final
+  {
+    if (std::isnan(a[0]) || std::isnan(a[1]) || std::isnan(a[2]))
+      return empty();
+
+    const auto min(std::fmin(a[1], a[2]));
+    const auto max(std::fmax(a[1], a[2]));
+
+    return std::isless(a[0], min) || std::isgreater(a[0], max) ? a[4] : a[3];
+  }
 };
 
 ///
 /// "If equal" operator.
 ///
-class ife : public function
+class ife : public function, public vector_kernel
 {
 public:
   explicit ife(const cvect &c = {0, 0})
@@ -432,6 +534,20 @@ public:
       return args[3];
   }
 
+  void eval_columns(const const_column args[], column out,
+                    std::size_t n) const final
+  {
+    kernel::ife(args, out, n);
+  }
+
+  base_t eval_scalar(const base_t a[]) const final
+  {
+    if (std::isnan(a[0]) || std::isnan(a[1]))
+      return empty();
+
+    return issmall(a[0] - a[1]) ? a[2] : a[3];
+  }
+
   double penalty_nvi(core_interpreter *ci) const final
   {
     return comparison_function_penalty(ci);
@@ -441,7 +557,7 @@ public:
 ///
 /// "If less then" operator.
 ///
-class ifl : public function
+class ifl : public function, public vector_kernel
 {
 public:
   explicit ifl(const cvect &c  = {0, 0})
@@ -472,6 +588,20 @@ public:
       return args[3];
   }
 
+  void eval_columns(const const_column args[], column out,
+                    std::size_t n) const final
+  {
+    kernel::ifl(args, out, n);
+  }
+
+  base_t eval_scalar(const base_t a[]) const final
+  {
+    if (std::isnan(a[0]) || std::isnan(a[1]))
+      return empty();
+
+    return std::isless(a[0], a[1]) ? a[2] : a[3];
+  }
+
   double penalty_nvi(core_interpreter *ci) const final
   {
     return comparison_function_penalty(ci);
@@ -481,7 +611,7 @@ public:
 ///
 /// "If zero" operator.
 ///
-class ifz : public function
+class ifz : public function, public vector_kernel
 {
 public:
   explicit ifz(const cvect &c = {0})
@@ -514,6 +644,20 @@ public:
     else
       return args[2];
   }
+
+  void eval_columns(const const_column args[], column out,
+                    std::size_t n) const final
+  {
+    kernel::ifz(args, out, n);
+  }
+
+  base_t eval_scalar(const base_t a[]) const final
+  {
+    if (std::isnan(a[0]))
+      return empty();
+
+    return issmall(a[0]) ? a[1] : a[2];
+  }
 };
 
 ///
@@ -548,7 +692,7 @@ public:
 ///
 /// Natural logarithm of a real number.
 ///
-class ln : public function
+class ln : public function, public vector_kernel
 {
 public:
   explicit ln(const cvect &c = {0}) : function("FLN", c[0], {c[0]})
@@ -579,6 +723,17 @@ public:
 
     return ret;
   }
+
+  void eval_columns(const const_column args[], column out,
+                    std::size_t n) const final
+  {
+    kernel::ln(args[0], out, n);
+  }
+
+  base_t eval_scalar(const base_t a[]) const final
+  {
+    return finite_or_nan(std::log(a[0]));
+  }
 };
 
 ///
@@ -617,7 +772,7 @@ public:
 ///
 /// The larger of two floating point values.
 ///
-class max : public function
+class max : public function, public vector_kernel
 {
 public:
   explicit max(const cvect &c = {0}) : function("FMAX", c[0], {c[0], c[0]})
@@ -646,12 +801,26 @@ public:
 
     return ret;
   }
+
+  void eval_columns(const const_column args[], column out,
+                    std::size_t n) const final
+  {
+    kernel::max(args[0], args[1], out, n);
+  }
+
+  base_t eval_scalar(const base_t a[]) const final
+  {
+    if (std::isnan(a[0]) || std::isnan(a[1]))
+      return empty();
+
+    return finite_or_nan(std::fmax(a[0], a[1]));
+  }
 };
 
 ///
 /// Remainder of the division between real numbers.
 ///
-class mod : public function
+class mod : public function, public vector_kernel
 {
 public:
   explicit mod(const cvect &c = {0}) : function("FMOD", c[0], {c[0], c[0]})
@@ -681,12 +850,23 @@ public:
 
     return ret;
   }
+
+  void eval_columns(const const_column args[], column out,
+                    std::size_t n) const final
+  {
+    kernel::mod(args[0], args[1], out, n);
+  }
+
+  base_t eval_scalar(const base_t a[]) const final
+  {
+    return finite_or_nan(std::fmod(a[0], a[1]));
+  }
 };
 
 ///
 /// Product of real numbers.
 ///
-class mul : public function
+class mul : public function, public vector_kernel
 {
 public:
   explicit mul(const cvect &c = {0}) : function("FMUL", c[0], {c[0], c[0]})
@@ -710,12 +890,23 @@ public:
 
     return ret;
   }
+
+  void eval_columns(const const_column args[], column out,
+                    std::size_t n) const final
+  {
+    kernel::mul(args[0], args[1], out, n);
+  }
+
+  base_t eval_scalar(const base_t a[]) const final
+  {
+    return finite_or_nan(a[0] * a[1]);
+  }
 };
 
 ///
 /// sin() of a real number.
 ///
-class sin : public function
+class sin : public function, public vector_kernel
 {
 public:
   explicit sin(const cvect &c = {0}) : function("FSIN", c[0], {c[0]})
@@ -738,12 +929,23 @@ public:
 
     return std::sin(base(a));
   }
+
+  void eval_columns(const const_column args[], column out,
+                    std::size_t n) const final
+  {
+    kernel::sin(args[0], out, n);
+  }
+
+  base_t eval_scalar(const base_t a[]) const final
+  {
+    return std::sin(a[0]);
+  }
 };
 
 ///
 /// Square root of a real number.
 ///
-class sqrt : public function
+class sqrt : public function, public vector_kernel
 {
 public:
   explicit sqrt(const cvect &c = {0}) : function("FSQRT", c[0], {c[0]})
@@ -770,12 +972,26 @@ public:
 
     return std::sqrt(v);
   }
+
+  void eval_columns(const const_column args[], column out,
+                    std::size_t n) const final
+  {
+    kernel::sqrt(args[0], out, n);
+  }
+
+  base_t eval_scalar(const base_t a[]) const final
+  {
+    if (std::isless(a[0], 0.0))
+      return empty();
+
+    return std::sqrt(a[0]);
+  }
 };
 
 ///
 /// Subtraction between real numbers.
 ///
-class sub : public function
+class sub : public function, public vector_kernel
 {
 public:
   explicit sub(const cvect &c = {0}) : function("FSUB", c[0], {c[0], c[0]})
@@ -799,13 +1015,24 @@ public:
 
     return ret;
   }
+
+  void eval_columns(const const_column args[], column out,
+                    std::size_t n) const final
+  {
+    kernel::sub(args[0], args[1], out, n);
+  }
+
+  base_t eval_scalar(const base_t a[]) const final
+  {
+    return finite_or_nan(a[0] - a[1]);
+  }
 };
 
 
 ///
 /// Sigmoid function.
 ///
-class sigmoid : public function
+class sigmoid : public function, public vector_kernel
 {
 public:
   explicit sigmoid(const cvect &c = {0}) : function("FSIGMOID", c[0], {c[0]})
@@ -837,6 +1064,20 @@ public:
 
     return std::exp(x) / (1.0 + std::exp(x));
   }
+
+  void eval_columns(const const_column args[], column out,
+                    std::size_t n) const final
+  {
+    kernel::sigmoid(args[0], out, n);
+  }
+
+  base_t eval_scalar(const base_t a[]) const final
+  {
+    const auto x(a[0]);
+    if (x >= 0.0)
+      return 1.0 / (1.0 + std::exp(-x));
+    return std::exp(x) / (1.0 + std::exp(x));
+  }
 };
 
 }  // namespace vita::real
@@ -0,0 +1,287 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2024 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#include <cmath>
+#include <limits>
+
+#include "kernel/gp/src/primitive/real_kernel.h"
+
+// Runtime CPU dispatch: the compiler emits an AVX2 and a baseline (SSE2 on
+// x86-64) version of every kernel and the dynamic loader binds the best one
+// for the running CPU (via `ifunc`). On other platforms kernels are compiled
+// once, for the target instruction set.
+#if defined(__GNUC__) && defined(__x86_64__) && defined(__linux__)
+#  define VITA_KERNEL __attribute__((target_clones("avx2", "default")))
+#else
+#  define VITA_KERNEL
+#endif
+
+namespace vita::real::kernel
+{
+
+namespace
+{
+
+// `false` for infinities / NaNs (comparisons with NaN are always false).
+// Unlike `std::isfinite` this is a plain arithmetic comparison and it's
+// vectorised; unlike `x - x == 0.0` it doesn't trigger `-Wfloat-equal`.
+inline mask_t finite(D_DOUBLE x)
+{
+  return std::fabs(x) <= std::numeric_limits<D_DOUBLE>::max();
+}
+
+// Same as `vita::issmall`.
+inline bool small(D_DOUBLE x)
+{
+  static constexpr D_DOUBLE e(std::numeric_limits<D_DOUBLE>::epsilon());
+
+  return std::fabs(x) < 2.0 * e;
+}
+
+// Branchless `out[i] = cond ? t[i] : f[i]` (value and validity). Both
+// branches are always loaded so that the compiler can use blend instructions.
+inline void select(bool cond, const_column t, const_column f, column out,
+                   std::size_t i)
+{
+  const D_DOUBLE tv(t.val[i]), fv(f.val[i]);
+  const mask_t to(t.ok[i]), fo(f.ok[i]);
+
+  out.val[i] = cond ? tv : fv;
+  out.ok[i] = cond ? to : fo;
+}
+
+}  // unnamed namespace
+
+VITA_KERNEL void abs(const_column a, column out, std::size_t n)
+{
+  for (std::size_t i(0); i < n; ++i)
+  {
+    out.val[i] = std::fabs(a.val[i]);
+    out.ok[i] = a.ok[i];
+  }
+}
+
+VITA_KERNEL void add(const_column a, const_column b,
+                     column out, std::size_t n)
+{
+  for (std::size_t i(0); i < n; ++i)
+  {
+    const D_DOUBLE r(a.val[i] + b.val[i]);
+    out.val[i] = r;
+    out.ok[i] = a.ok[i] & b.ok[i] & finite(r);
+  }
+}
+
+VITA_KERNEL void aq(const_column a, const_column b,
+                    column out, std::size_t n)
+{
+  for (std::size_t i(0); i < n; ++i)
+  {
+    const D_DOUBLE y(b.val[i]);
+    const D_DOUBLE r(a.val[i] / std::sqrt(1.0 + y * y));
+    out.val[i] = r;
+    out.ok[i] = a.ok[i] & b.ok[i] & finite(r);
+  }
+}
+
+VITA_KERNEL void cos(const_column a, column out, std::size_t n)
+{
+  for (std::size_t i(0); i < n; ++i)
+  {
+    out.val[i] = std::cos(a.val[i]);
+    out.ok[i] = a.ok[i];
+  }
+}
+
+VITA_KERNEL void div(const_column a, const_column b,
+                     column out, std::size_t n)
+{
+  for (std::size_t i(0); i < n; ++i)
+  {
+    const D_DOUBLE r(a.val[i] / b.val[i]);
+    out.val[i] = r;
+    out.ok[i] = a.ok[i] & b.ok[i] & finite(r);
+  }
+}
+
+VITA_KERNEL void idiv(const_column a, const_column b,
+                      column out, std::size_t n)
+{
+  for (std::size_t i(0); i < n; ++i)
+  {
+    const D_DOUBLE r(std::floor(a.val[i] / b.val[i]));
+    out.val[i] = r;
+    out.ok[i] = a.ok[i] & b.ok[i] & finite(r);
+  }
+}
+
+///
+/// "If between".
+///
+/// `args[3]` when `args[0]` is in the `[args[1], args[2]]` range, otherwise
+/// `args[4]`.
+///
+VITA_KERNEL void ifb(const const_column args[], column out,
+                     std::size_t n)
+{
+  const const_column a(args[0]), b(args[1]), c(args[2]), t(args[3]),
+                     f(args[4]);
+
+  for (std::size_t i(0); i < n; ++i)
+  {
+    const D_DOUBLE min(std::fmin(b.val[i], c.val[i]));
+    const D_DOUBLE max(std::fmax(b.val[i], c.val[i]));
+    const bool out_of_range((a.val[i] < min) | (a.val[i] > max));
+
+    select(!out_of_range, t, f, out, i);
+    out.ok[i] &= a.ok[i] & b.ok[i] & c.ok[i];
+  }
+}
+
+///
+/// "If equal".
+///
+VITA_KERNEL void ife(const const_column args[], column out,
+                     std::size_t n)
+{
+  const const_column a(args[0]), b(args[1]), t(args[2]), f(args[3]);
+
+  for (std::size_t i(0); i < n; ++i)
+  {
+    select(small(a.val[i] - b.val[i]), t, f, out, i);
+    out.ok[i] &= a.ok[i] & b.ok[i];
+  }
+}
+
+///
+/// "If less".
+///
+VITA_KERNEL void ifl(const const_column args[], column out,
+                     std::size_t n)
+{
+  const const_column a(args[0]), b(args[1]), t(args[2]), f(args[3]);
+
+  for (std::size_t i(0); i < n; ++i)
+  {
+    select(a.val[i] < b.val[i], t, f, out, i);
+    out.ok[i] &= a.ok[i] & b.ok[i];
+  }
+}
+
+///
+/// "If zero".
+///
+VITA_KERNEL void ifz(const const_column args[], column out,
+                     std::size_t n)
+{
+  const const_column a(args[0]), t(args[1]), f(args[2]);
+
+  for (std::size_t i(0); i < n; ++i)
+  {
+    select(small(a.val[i]), t, f, out, i);
+    out.ok[i] &= a.ok[i];
+  }
+}
+
+VITA_KERNEL void ln(const_column a, column out, std::size_t n)
+{
+  for (std::size_t i(0); i < n; ++i)
+  {
+    const D_DOUBLE r(std::log(a.val[i]));
+    out.val[i] = r;
+    out.ok[i] = a.ok[i] & finite(r);
+  }
+}
+
+VITA_KERNEL void max(const_column a, const_column b,
+                     column out, std::size_t n)
+{
+  for (std::size_t i(0); i < n; ++i)
+  {
+    const D_DOUBLE r(std::fmax(a.val[i], b.val[i]));
+    out.val[i] = r;
+    out.ok[i] = a.ok[i] & b.ok[i] & finite(r);
+  }
+}
+
+VITA_KERNEL void mod(const_column a, const_column b,
+                     column out, std::size_t n)
+{
+  for (std::size_t i(0); i < n; ++i)
+  {
+    const D_DOUBLE r(std::fmod(a.val[i], b.val[i]));
+    out.val[i] = r;
+    out.ok[i] = a.ok[i] & b.ok[i] & finite(r);
+  }
+}
+
+VITA_KERNEL void mul(const_column a, const_column b,
+                     column out, std::size_t n)
+{
+  for (std::size_t i(0); i < n; ++i)
+  {
+    const D_DOUBLE r(a.val[i] * b.val[i]);
+    out.val[i] = r;
+    out.ok[i] = a.ok[i] & b.ok[i] & finite(r);
+  }
+}
+
+///
+/// Sigmoid function.
+///
+/// Both the `x >= 0` and the `x < 0` formulations of the scalar version use
+/// `exp(-|x|)`, so there's a single (overflow free) exponential.
+///
+VITA_KERNEL void sigmoid(const_column a, column out,
+                         std::size_t n)
+{
+  for (std::size_t i(0); i < n; ++i)
+  {
+    const D_DOUBLE x(a.val[i]);
+    const D_DOUBLE e(std::exp(-std::fabs(x)));
+
+    out.val[i] = (x >= 0.0 ? 1.0 : e) / (1.0 + e);
+    out.ok[i] = a.ok[i];
+  }
+}
+
+VITA_KERNEL void sin(const_column a, column out, std::size_t n)
+{
+  for (std::size_t i(0); i < n; ++i)
+  {
+    out.val[i] = std::sin(a.val[i]);
+    out.ok[i] = a.ok[i];
+  }
+}
+
+VITA_KERNEL void sqrt(const_column a, column out, std::size_t n)
+{
+  for (std::size_t i(0); i < n; ++i)
+  {
+    const D_DOUBLE v(a.val[i]);
+    out.val[i] = std::sqrt(v);
+    out.ok[i] = a.ok[i] & !(v < 0.0);
+  }
+}
+
+VITA_KERNEL void sub(const_column a, const_column b,
+                     column out, std::size_t n)
+{
+  for (std::size_t i(0); i < n; ++i)
+  {
+    const D_DOUBLE r(a.val[i] - b.val[i]);
+    out.val[i] = r;
+    out.ok[i] = a.ok[i] & b.ok[i] & finite(r);
+  }
+}
+
+}  // namespace vita::real::kernel
@@ -0,0 +1,115 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2024 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#if !defined(VITA_REAL_KERNEL_H)
+#define      VITA_REAL_KERNEL_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "kernel/value.h"
+
+/// Vectorised versions of the real-valued primitives.
+///
+/// A kernel computes a primitive over whole columns of values. Every column
+/// comes with a validity mask: a `0` element of the mask stands for the empty
+/// value (the value of the corresponding element of the column is garbage).
+/// The semantic of the scalar `eval` functions is preserved: a non-finite
+/// result becomes an empty value and conditional functions select the value
+/// (and the validity) of the chosen branch without branching.
+///
+/// Kernels are compiled for many instruction sets (AVX2 and the x86-64
+/// baseline SSE2); the best version for the running CPU is selected at load
+/// time.
+namespace vita::real
+{
+
+/// Element of a validity mask (`0` means *empty value*).
+///
+/// \remark
+/// It has the same width of the values: mixing widths in the same loop
+/// prevents the vectorisation of the conditional kernels.
+using mask_t = std::uint64_t;
+
+///
+/// A read-only column of real values with its validity mask.
+///
+struct const_column
+{
+  const D_DOUBLE *val;
+  const mask_t *ok;
+};
+
+///
+/// A column of real values with its validity mask.
+///
+struct column
+{
+  D_DOUBLE *val;
+  mask_t *ok;
+};
+
+///
+/// Interface for primitives providing a vectorised kernel.
+///
+class vector_kernel
+{
+public:
+  virtual ~vector_kernel() = default;
+
+  /// Computes the primitive for `n` elements.
+  ///
+  /// \param[in]  args columns of the arguments (one for every argument)
+  /// \param[out] out  results
+  /// \param[in]  n    number of elements of every column
+  virtual void eval_columns(const const_column args[], column out,
+                            std::size_t n) const = 0;
+
+  /// Computes the primitive for a single element without the `value_t`
+  /// wrapper.
+  ///
+  /// \param[in] args values of the arguments (NaN stands for the empty
+  ///                 value)
+  /// \return         the result (NaN for the empty value)
+  ///
+  /// \remark
+  /// Arguments must be finite numbers or NaN: then NaN can represent the empty
+  /// value without ambiguity (none of the scalar `eval` functions returns a
+  /// non-finite value for finite arguments).
+  virtual D_DOUBLE eval_scalar(const D_DOUBLE args[]) const = 0;
+};
+
+namespace kernel
+{
+void abs(const_column, column, std::size_t);
+void add(const_column, const_column, column, std::size_t);
+void aq(const_column, const_column, column, std::size_t);
+void cos(const_column, column, std::size_t);
+void div(const_column, const_column, column, std::size_t);
+void idiv(const_column, const_column, column, std::size_t);
+void ifb(const const_column[], column, std::size_t);
+void ife(const const_column[], column, std::size_t);
+void ifl(const const_column[], column, std::size_t);
+void ifz(const const_column[], column, std::size_t);
+void ln(const_column, column, std::size_t);
+void max(const_column, const_column, column, std::size_t);
+void mod(const_column, const_column, column, std::size_t);
+void mul(const_column, const_column, column, std::size_t);
+void sigmoid(const_column, column, std::size_t);
+void sin(const_column, column, std::size_t);
+void sqrt(const_column, column, std::size_t);
+void sub(const_column, const_column, column, std::size_t);
+}  // namespace kernel
+
+}  // namespace vita::real
+
+#endif  // include guard
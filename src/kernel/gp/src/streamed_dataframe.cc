@@ -0,0 +1,293 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2024 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#include <sstream>
+
+#include "kernel/gp/src/streamed_dataframe.h"
+
+namespace vita
+{
+
+namespace
+{
+
+// Number of lines used to deduce the metadata of the dataset.
+constexpr unsigned k_head_lines = 64;
+
+bool is_blank(const std::string &line)
+{
+  return line.find_first_not_of(" \t\r") == std::string::npos;
+}
+
+}  // unnamed namespace
+
+///
+/// Prepares a CSV file for streaming.
+///
+/// \param[in] fn    the CSV file
+/// \param[in] p     additional, optional, parameters (see
+///                  `dataframe::params`)
+/// \param[in] block number of examples per block
+///
+/// \exception std::runtime_error           cannot read CSV data file
+/// \exception std::invalid_argument        filters aren't supported
+/// \exception exception::insufficient_data empty / undersized data file
+///
+/// Only the first lines of the file are read here (to build the metadata).
+///
+streamed_dataframe::streamed_dataframe(const std::filesystem::path &fn,
+                                       dataframe::params p,
+                                       std::size_t block)
+  : file_(fn), params_(), schema_(), head_(), head_end_(0), variables_(0),
+    block_size_(block)
+{
+  Expects(block);
+
+  if (p.filter)
+    throw std::invalid_argument("Filters aren't supported by streamed data");
+
+  std::ifstream in(fn, std::ios::binary);
+  if (!in)
+    throw std::runtime_error("Cannot read CSV data file");
+
+  std::string sample;
+  std::string line;
+  for (unsigned i(0); i < k_head_lines && std::getline(in, line); ++i)
+  {
+    sample += line;
+    sample += '\n';
+  }
+  head_end_ = static_cast<std::streamoff>(sample.size());
+
+  // The dialect must be fully specified before reading blocks without the
+  // header.
+  if (p.dialect.has_header == pocket_csv::dialect::GUESS_HEADER
+      || !p.dialect.delimiter)
+  {
+    std::istringstream ss(sample);
+    const auto sniff(pocket_csv::sniffer(ss));
+
+    if (p.dialect.has_header == pocket_csv::dialect::GUESS_HEADER)
+      p.dialect.has_header = sniff.has_header;
+    if (!p.dialect.delimiter)
+      p.dialect.delimiter = sniff.delimiter;
+  }
+
+  std::istringstream ss(sample);
+  schema_.read_csv(ss, p);
+
+  variables_ = schema_.variables();
+  params_ = p;
+
+  head_.assign(std::make_move_iterator(schema_.begin()),
+               std::make_move_iterator(schema_.end()));
+  schema_.clear();
+
+  Ensures(!head_.empty());
+}
+
+///
+/// \return an iterator to the first example of the dataset
+///
+/// \remark Every iterator obtained from `begin()` starts a new scan of the
+///         file.
+///
+streamed_dataframe::const_iterator streamed_dataframe::begin() const
+{
+  return const_iterator(*this);
+}
+
+///
+/// \return the sentinel value
+///
+streamed_dataframe::const_iterator streamed_dataframe::end() const
+{
+  return {};
+}
+
+///
+/// \return number of input variables
+///
+unsigned streamed_dataframe::variables() const
+{
+  return variables_;
+}
+
+///
+/// \return maximum number of examples of a block
+///
+std::size_t streamed_dataframe::block_size() const
+{
+  return block_size_;
+}
+
+///
+/// \return information about the columns of the dataset
+///
+/// \remark States of textual features and classes are the ones found in the
+///         first lines of the file.
+///
+const dataframe::columns_info &streamed_dataframe::columns() const
+{
+  return schema_.columns;
+}
+
+///
+/// Starts reading the dataset.
+///
+/// \param[in] d the dataset
+///
+/// The first block (after the examples already read by the constructor) is
+/// immediately requested.
+///
+streamed_dataframe::cursor::cursor(const streamed_dataframe &d)
+  : data_(d), schema_(d.schema_), in_(d.file_, std::ios::binary),
+    started_(false), current_(), next_()
+{
+  if (!in_)
+    throw std::runtime_error("Cannot read CSV data file");
+
+  in_.seekg(d.head_end_);
+  prefetch();
+}
+
+///
+/// Waits for the background reader.
+///
+streamed_dataframe::cursor::~cursor()
+{
+  if (next_.valid())
+    next_.wait();
+}
+
+///
+/// \return a pointer to the next block of examples (`nullptr` at the end of
+///         the dataset)
+///
+/// The returned block remains valid until the next call.
+///
+const streamed_dataframe::block_t *streamed_dataframe::cursor::next()
+{
+  if (!started_)
+  {
+    started_ = true;
+    return &data_.head_;
+  }
+
+  if (!next_.valid())
+    return nullptr;
+
+  current_ = next_.get();
+  if (current_.empty())
+    return nullptr;
+
+  prefetch();
+  return &current_;
+}
+
+///
+/// Reads the next block of examples from the file.
+///
+/// \return the block (empty at the end of the file)
+///
+/// \remark Runs on a background thread: only `in_` and `schema_` are accessed.
+///
+streamed_dataframe::block_t streamed_dataframe::cursor::read_block()
+{
+  std::string text;
+  std::string line;
+
+  // Skips blocks containing only malformed examples.
+  while (schema_.empty() && in_)
+  {
+    text.clear();
+    for (std::size_t lines(0);
+         lines < data_.block_size_ && std::getline(in_, line);)
+    {
+      if (is_blank(line))
+        continue;
+
+      text += line;
+      text += '\n';
+      ++lines;
+    }
+
+    if (text.empty())
+      return {};
+
+    schema_.append_csv(text, data_.params_);
+  }
+
+  block_t ret(std::make_move_iterator(schema_.begin()),
+              std::make_move_iterator(schema_.end()));
+  schema_.clear();
+
+  return ret;
+}
+
+///
+/// Starts reading the next block in background.
+///
+void streamed_dataframe::cursor::prefetch()
+{
+  next_ = std::async(std::launch::async, [this] { return read_block(); });
+}
+
+///
+/// Starts a new scan of the dataset.
+///
+/// \param[in] d the dataset
+///
+streamed_dataframe::const_iterator::const_iterator(const streamed_dataframe &d)
+  : cursor_(std::make_shared<cursor>(d)), block_(cursor_->next()), pos_(0)
+{
+  skip_empty_blocks();
+}
+
+///
+/// \return an iterator to the next example
+///
+streamed_dataframe::const_iterator &
+streamed_dataframe::const_iterator::operator++()
+{
+  ++pos_;
+  skip_empty_blocks();
+
+  return *this;
+}
+
+///
+/// \param[in] rhs second term of comparison
+/// \return        `true` if the iterators refer to the same example
+///
+/// \remark As for every input iterator, comparison is only meaningful between
+///         an iterator and the sentinel.
+///
+bool streamed_dataframe::const_iterator::operator==(
+  const const_iterator &rhs) const
+{
+  return block_ == rhs.block_ && pos_ == rhs.pos_;
+}
+
+void streamed_dataframe::const_iterator::skip_empty_blocks()
+{
+  while (block_ && pos_ >= block_->size())
+  {
+    block_ = cursor_->next();
+    pos_ = 0;
+  }
+
+  if (!block_)
+    cursor_.reset();
+}
+
+}  // namespace vita
@@ -0,0 +1,171 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2024 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#if !defined(VITA_STREAMED_DATAFRAME_H)
+#define      VITA_STREAMED_DATAFRAME_H
+
+#include <fstream>
+#include <future>
+#include <memory>
+
+#include "kernel/gp/src/dataframe.h"
+
+namespace vita
+{
+///
+/// A CSV dataset read in blocks of examples, for datasets larger than the
+/// available memory.
+///
+/// Only a block of examples (plus the one being prefetched by a background
+/// thread) is resident at any given time. Every scan of the dataset reads
+/// the file again.
+///
+/// The object satisfies the requirements for the dataset of
+/// `src_evaluator` / `sum_of_errors_evaluator` (it's iterable) and the
+/// evaluators process it block by block (see `for_each_block`).
+///
+/// \remark
+/// Metadata (columns' domains, header, dialect) is deduced from the first
+/// lines of the file, exactly like `dataframe::read_csv`.
+///
+/// \warning
+/// - Examples are read-only: the Dynamic Subset Selection algorithm (which
+///   changes the difficulty of the examples) cannot be used.
+/// - Filters (`dataframe::params::filter`) aren't supported.
+///
+class streamed_dataframe
+{
+public:
+  using example = dataframe::example;
+  using value_type = example;
+  using block_t = dataframe::examples_t;
+
+  explicit streamed_dataframe(const std::filesystem::path &,
+                              dataframe::params = {},
+                              std::size_t = 16384);
+
+  class const_iterator;
+  [[nodiscard]] const_iterator begin() const;
+  [[nodiscard]] const_iterator end() const;
+
+  template<class F> void for_each_block(F) const;
+
+  [[nodiscard]] unsigned variables() const;
+  [[nodiscard]] std::size_t block_size() const;
+  [[nodiscard]] const dataframe::columns_info &columns() const;
+
+private:
+  class cursor;
+
+  std::filesystem::path file_;
+
+  // Fully specified dialect and output column.
+  dataframe::params params_;
+
+  // Empty dataframe with the metadata of the dataset.
+  dataframe schema_;
+
+  // The first examples (read while building the metadata) and the position
+  // of the remaining ones in the file.
+  block_t head_;
+  std::streamoff head_end_;
+
+  unsigned variables_;
+  std::size_t block_size_;
+};
+
+///
+/// Reads the blocks of a `streamed_dataframe` in sequence.
+///
+/// While the current block is processed, the next one is read by a
+/// background thread.
+///
+class streamed_dataframe::cursor
+{
+public:
+  explicit cursor(const streamed_dataframe &);
+  ~cursor();
+
+  cursor(const cursor &) = delete;
+  cursor &operator=(const cursor &) = delete;
+
+  [[nodiscard]] const block_t *next();
+
+private:
+  [[nodiscard]] block_t read_block();
+  void prefetch();
+
+  const streamed_dataframe &data_;
+
+  // Every cursor converts records by itself (the conversion can change the
+  // metadata, e.g. adding states of textual features).
+  dataframe schema_;
+
+  std::ifstream in_;
+  bool started_;
+
+  block_t current_;
+  std::future<block_t> next_;
+};
+
+///
+/// An input iterator over the examples of a `streamed_dataframe`.
+///
+class streamed_dataframe::const_iterator
+{
+public:
+  using iterator_category = std::input_iterator_tag;
+  using difference_type = std::ptrdiff_t;
+  using value_type = example;
+  using pointer = const value_type *;
+  using reference = const value_type &;
+
+  const_iterator() = default;
+  explicit const_iterator(const streamed_dataframe &);
+
+  const_iterator &operator++();
+
+  [[nodiscard]] reference operator*() const { return (*block_)[pos_]; }
+  [[nodiscard]] pointer operator->() const { return &operator*(); }
+
+  [[nodiscard]] bool operator==(const const_iterator &) const;
+  [[nodiscard]] bool operator!=(const const_iterator &rhs) const
+  { return !(*this == rhs); }
+
+private:
+  void skip_empty_blocks();
+
+  std::shared_ptr<cursor> cursor_ = nullptr;
+  const block_t *block_ = nullptr;
+  std::size_t pos_ = 0;
+};
+
+///
+/// Calls a function for every block of the dataset.
+///
+/// \param[in] f a function receiving a `const block_t &`
+///
+/// Blocks are passed in file order; the next block is read while `f` is
+/// running.
+///
+template<class F>
+void streamed_dataframe::for_each_block(F f) const
+{
+  cursor c(*this);
+
+  while (const auto *b = c.next())
+    f(*b);
+}
+
+}  // namespace vita
+
+#endif  // include guard
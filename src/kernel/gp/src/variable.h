@@ -40,6 +40,9 @@ public:
   /// \note Requires a src_interpreter to work.
   value_t eval(symbol_params &p) const override { return p.fetch_var(var_); }
 
+  /// \return the index of the feature associated with the variable
+  [[nodiscard]] unsigned var_id() const { return var_; }
+
 private:
   unsigned var_;
 };
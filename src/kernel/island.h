@@ -0,0 +1,52 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2024 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#if !defined(VITA_ISLAND_H)
+#define      VITA_ISLAND_H
+
+namespace vita::island
+{
+
+///
+/// How islands are connected (i.e. where migrants go).
+///
+enum class topology
+{
+  ring,     /// island `i` sends migrants to island `i+1` (modulo islands)
+  random,   /// every island sends migrants to a random island
+  complete  /// every island sends migrants to all the other islands
+};
+
+///
+/// Parameters for the island model.
+///
+/// The population is split in many sub-populations (islands) evolving
+/// independently. Periodically islands exchange their best individuals
+/// (migration).
+///
+struct parameters
+{
+  /// Islands exchange individuals every `migration_interval` generations.
+  ///
+  /// \note A value of 0 disables migration.
+  unsigned migration_interval = 10;
+
+  /// Number of individuals an island sends to each of its neighbours.
+  unsigned migrants = 1;
+
+  /// Connection scheme of the islands.
+  island::topology topology = topology::ring;
+};
+
+}  // namespace vita::island
+
+#endif  // include guard
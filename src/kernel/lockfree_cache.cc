@@ -0,0 +1,391 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2024 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#include <algorithm>
+
+#include "kernel/lockfree_cache.h"
+
+namespace vita
+{
+///
+/// Creates a new hash table.
+///
+/// \param[in] bits `2^bits` is the number of elements of the table
+///
+/// \remark
+/// The number of elements is rounded up to a multiple of `k_ways`.
+///
+lockfree_cache::lockfree_cache(unsigned bits)
+  : k_mask(std::max<std::uint64_t>((1ull << bits) / k_ways, 1) - 1),
+    table_(new slot[(k_mask + 1) * k_ways]), seal_(1), tick_(0), hits_(0),
+    misses_(0), evictions_(0), collisions_(0)
+{
+  Expects(bits);
+
+  // Before C++20 `std::atomic` default constructor doesn't initialize the
+  // value. A `0` seal is never valid.
+  for (std::size_t i(0); i < (k_mask + 1) * k_ways; ++i)
+  {
+    slot &s(table_[i]);
+
+    s.seq.store(0, std::memory_order_relaxed);
+    s.seal.store(0, std::memory_order_relaxed);
+    s.hash[0].store(0, std::memory_order_relaxed);
+    s.hash[1].store(0, std::memory_order_relaxed);
+    s.birth.store(0, std::memory_order_relaxed);
+    s.size.store(0, std::memory_order_relaxed);
+    for (auto &v : s.fitness)
+      v.store(0, std::memory_order_relaxed);
+  }
+
+  Ensures(is_valid());
+}
+
+///
+/// \param[in] h the signature of an individual
+/// \return      the first slot of the bucket where `h` can be stored
+///
+inline lockfree_cache::slot *lockfree_cache::bucket_of(const hash_t &h) const
+{
+  return &table_[(h.data[0] & k_mask) * k_ways];
+}
+
+///
+/// Reads a slot.
+///
+/// \param[in]  s   a slot of the table
+/// \param[out] out a copy of the content of `s`
+/// \return         `true` if the copy is consistent (the slot wasn't written
+///                 during the read)
+///
+bool lockfree_cache::read(const slot &s, snapshot &out) const
+{
+  out.seq = s.seq.load(std::memory_order_acquire);
+  if (out.seq & 1)
+    return false;
+
+  out.seal = s.seal.load(std::memory_order_relaxed);
+  out.hash.data[0] = s.hash[0].load(std::memory_order_relaxed);
+  out.hash.data[1] = s.hash[1].load(std::memory_order_relaxed);
+  out.birth = s.birth.load(std::memory_order_relaxed);
+
+  out.size = std::min<std::uint32_t>(s.size.load(std::memory_order_relaxed),
+                                     k_fitness_size);
+  for (std::size_t i(0); i < k_fitness_size; ++i)
+    out.fitness[i] = s.fitness[i].load(std::memory_order_relaxed);
+
+  // Orders the previous loads before the check of the sequence number.
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return s.seq.load(std::memory_order_relaxed) == out.seq;
+}
+
+///
+/// \param[in] s a copy of a slot
+/// \return      `true` if `s` contains an entry of the current generation
+///
+inline bool lockfree_cache::valid(const snapshot &s) const
+{
+  return s.seal == seal_.load(std::memory_order_relaxed) && !s.hash.empty();
+}
+
+///
+/// \param[in] s a consistent copy of a slot
+/// \return      the fitness stored in `s`
+///
+fitness_t lockfree_cache::to_fitness(const snapshot &s)
+{
+  fitness_t ret(with_size(s.size));
+  std::copy(s.fitness.begin(), s.fitness.begin() + s.size, ret.begin());
+
+  return ret;
+}
+
+///
+/// Clears the content of the table.
+///
+/// \note
+/// Allocated size isn't changed. Statistics are kept (they refer to the whole
+/// life of the table).
+///
+void lockfree_cache::clear()
+{
+  seal_.fetch_add(1, std::memory_order_relaxed);
+}
+
+///
+/// Clears the cached information for a specific individual.
+///
+/// \param[in] h individual's signature whose informations we have to clear
+///
+void lockfree_cache::clear(const hash_t &h)
+{
+  slot *b(bucket_of(h));
+
+  for (std::size_t i(0); i < k_ways; ++i)
+  {
+    slot &s(b[i]);
+    snapshot ss;
+
+    if (read(s, ss) && ss.hash == h
+        && s.seq.compare_exchange_strong(ss.seq, ss.seq + 1,
+                                         std::memory_order_relaxed))
+    {
+      std::atomic_thread_fence(std::memory_order_release);
+      s.seal.store(0, std::memory_order_relaxed);
+      s.seq.store(ss.seq + 2, std::memory_order_release);
+    }
+  }
+}
+
+///
+/// Looks for the fitness of an individual in the transposition table.
+///
+/// \param[in] h individual's signature to look for
+/// \return      the fitness of the individual. If the individuals isn't
+///              present (or is being written) returns an empty fitness
+///
+fitness_t lockfree_cache::find(const hash_t &h) const
+{
+  const slot *b(bucket_of(h));
+
+  for (std::size_t i(0); i < k_ways; ++i)
+  {
+    snapshot s;
+
+    if (read(b[i], s) && s.hash == h && valid(s))
+    {
+      hits_.fetch_add(1, std::memory_order_relaxed);
+      return to_fitness(s);
+    }
+  }
+
+  misses_.fetch_add(1, std::memory_order_relaxed);
+  return {};
+}
+
+///
+/// Stores fitness information in the transposition table.
+///
+/// \param[in] h       a (possibly) new individual's signature to be stored in
+///                    the table
+/// \param[in] fitness the fitness of the individual
+///
+void lockfree_cache::insert(const hash_t &h, const fitness_t &fitness)
+{
+  store(h, fitness);
+}
+
+///
+/// Places an entry in its bucket.
+///
+/// \param[in] h       signature of an individual
+/// \param[in] fitness the fitness of the individual
+/// \return            `true` if the entry has been stored
+///
+/// The replacement policy is the same of `cache` (same slot, free slot,
+/// oldest entry). The choice is made on a snapshot of the bucket: if the
+/// chosen slot changes before it's acquired the insertion is dropped.
+///
+bool lockfree_cache::store(const hash_t &h, const fitness_t &fitness)
+{
+  if (fitness.size() > k_fitness_size)
+    return false;
+
+  slot *b(bucket_of(h));
+  const auto now(tick_.fetch_add(1, std::memory_order_relaxed));
+
+  slot *target(nullptr), *free(nullptr), *oldest(nullptr);
+  std::uint32_t target_seq(0), free_seq(0), oldest_seq(0), oldest_age(0);
+  bool others(false);
+
+  for (std::size_t i(0); i < k_ways; ++i)
+  {
+    snapshot s;
+    if (!read(b[i], s))
+      continue;  // another thread is writing this slot
+
+    if (!valid(s))
+    {
+      if (!free)
+      {
+        free = &b[i];
+        free_seq = s.seq;
+      }
+    }
+    else if (s.hash == h)
+    {
+      target = &b[i];
+      target_seq = s.seq;
+      break;
+    }
+    else
+    {
+      others = true;
+
+      // Ages are computed with unsigned arithmetic: wrap-around safe.
+      const std::uint32_t age(now - s.birth);
+      if (!oldest || age > oldest_age)
+      {
+        oldest = &b[i];
+        oldest_seq = s.seq;
+        oldest_age = age;
+      }
+    }
+  }
+
+  bool eviction(false);
+  if (!target)
+  {
+    if (free)
+    {
+      target = free;
+      target_seq = free_seq;
+    }
+    else if (oldest)
+    {
+      target = oldest;
+      target_seq = oldest_seq;
+      eviction = true;
+    }
+    else
+      return false;
+  }
+
+  // Acquires the slot (odd sequence number).
+  if (!target->seq.compare_exchange_strong(target_seq, target_seq + 1,
+                                           std::memory_order_relaxed))
+    return false;
+
+  // Orders the previous store before the following ones (the pairing acquire
+  // fence is in `read`).
+  std::atomic_thread_fence(std::memory_order_release);
+
+  target->seal.store(seal_.load(std::memory_order_relaxed),
+                     std::memory_order_relaxed);
+  target->hash[0].store(h.data[0], std::memory_order_relaxed);
+  target->hash[1].store(h.data[1], std::memory_order_relaxed);
+  target->birth.store(now, std::memory_order_relaxed);
+  target->size.store(static_cast<std::uint32_t>(fitness.size()),
+                     std::memory_order_relaxed);
+  for (std::size_t i(0); i < fitness.size(); ++i)
+    target->fitness[i].store(fitness[i], std::memory_order_relaxed);
+
+  // Releases the slot.
+  target->seq.store(target_seq + 2, std::memory_order_release);
+
+  if (others)
+    collisions_.fetch_add(1, std::memory_order_relaxed);
+  if (eviction)
+    evictions_.fetch_add(1, std::memory_order_relaxed);
+
+  return true;
+}
+
+///
+/// \return the usage counters of the table
+///
+lockfree_cache::statistics lockfree_cache::stats() const
+{
+  statistics ret;
+
+  ret.hits       = hits_.load(std::memory_order_relaxed);
+  ret.misses     = misses_.load(std::memory_order_relaxed);
+  ret.evictions  = evictions_.load(std::memory_order_relaxed);
+  ret.collisions = collisions_.load(std::memory_order_relaxed);
+
+  return ret;
+}
+
+///
+/// \param[in] in input stream
+/// \return       `true` if the object is correctly loaded
+///
+/// \warning
+/// Not thread safe: no other thread can access the table during the load.
+///
+bool lockfree_cache::load(std::istream &in)
+{
+  std::uint32_t t_seal;
+  if (!(in >> t_seal))
+    return false;
+
+  std::size_t n;
+  if (!(in >> n))
+    return false;
+
+  seal_.store(t_seal, std::memory_order_relaxed);
+
+  for (decltype(n) i(0); i < n; ++i)
+  {
+    hash_t h;
+    if (!h.load(in))
+      return false;
+
+    fitness_t f;
+    if (!f.load(in))
+      return false;
+
+    store(h, f);
+  }
+
+  return true;
+}
+
+///
+/// \param[out] out output stream
+/// \return         `true` if the object was saved correctly
+///
+/// \remark
+/// The format is the same used by `cache`.
+///
+/// \warning
+/// Entries written during the save could be skipped.
+///
+bool lockfree_cache::save(std::ostream &out) const
+{
+  std::vector<snapshot> entries;
+
+  for (std::size_t i(0); i < (k_mask + 1) * k_ways; ++i)
+    if (snapshot s; read(table_[i], s) && valid(s))
+      entries.push_back(s);
+
+  out << seal_.load(std::memory_order_relaxed) << ' ' << '\n';
+  out << entries.size() << '\n';
+
+  for (const auto &s : entries)
+  {
+    s.hash.save(out);
+    to_fitness(s).save(out);
+  }
+
+  return out.good();
+}
+
+///
+/// \return `true` if the object passes the internal consistency check
+///
+/// \warning
+/// Meaningful only when no other thread is writing the table.
+///
+bool lockfree_cache::is_valid() const
+{
+  for (std::size_t i(0); i < (k_mask + 1) * k_ways; ++i)
+    if (table_[i].seq.load(std::memory_order_relaxed) & 1)
+    {
+      vitaERROR << "Slot locked by a writer";
+      return false;
+    }
+
+  return true;
+}
+
+}  // namespace vita
@@ -0,0 +1,117 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2024 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#if !defined(VITA_LOCKFREE_CACHE_H)
+#define      VITA_LOCKFREE_CACHE_H
+
+#include <array>
+#include <atomic>
+
+#include "kernel/cache.h"
+
+namespace vita
+{
+///
+/// A hash table linking individuals' signature to fitness, without locks.
+///
+/// It has the same interface and the same set-associative layout of `cache`
+/// but every slot is protected by its own sequence lock (seqlock):
+/// - readers never write shared memory and never wait; a read overlapping a
+///   write is simply reported as a miss;
+/// - writers acquire the slot with a single compare-and-swap; an insertion
+///   overlapping another writer on the same slot is dropped.
+///
+/// Both outcomes are harmless for a cache (the fitness is recalculated) and
+/// threads evaluating different individuals never contend.
+///
+/// \remark
+/// Fitnesses with more than `k_fitness_size` components aren't cached.
+///
+class lockfree_cache
+{
+public:
+  DISALLOW_COPY_AND_ASSIGN(lockfree_cache);
+
+  /// Number of slots of a bucket.
+  static constexpr std::size_t k_ways = cache::k_ways;
+
+  /// Maximum number of components of a cached fitness.
+  static constexpr std::size_t k_fitness_size = 3;
+
+  using statistics = cache::statistics;
+
+  explicit lockfree_cache(unsigned);
+
+  void clear();
+  void clear(const hash_t &);
+
+  void insert(const hash_t &, const fitness_t &);
+
+  fitness_t find(const hash_t &) const;
+
+  statistics stats() const;
+
+  bool is_valid() const;
+
+  // Serialization.
+  bool load(std::istream &);
+  bool save(std::ostream &) const;
+
+private:
+  // Private data members.
+  struct alignas(64) slot
+  {
+    /// Sequence number: odd while the slot is being written.
+    std::atomic<std::uint32_t> seq;
+    /// Valid slots are recognized comparing their seal with the current one.
+    std::atomic<std::uint32_t> seal;
+    /// This is used as primary key for access to the table.
+    std::array<std::atomic<std::uint64_t>, 2> hash;
+    /// Insertion time (used by the replacement policy).
+    std::atomic<std::uint32_t> birth;
+    /// Number of components of the stored fitness.
+    std::atomic<std::uint32_t> size;
+    /// The stored fitness of an individual.
+    std::array<std::atomic<fitness_t::value_type>, k_fitness_size> fitness;
+  };
+
+  // A consistent copy of a slot.
+  struct snapshot
+  {
+    std::uint32_t seq;
+    std::uint32_t seal;
+    hash_t hash;
+    std::uint32_t birth;
+    std::uint32_t size;
+    std::array<fitness_t::value_type, k_fitness_size> fitness;
+  };
+
+  // Private support methods.
+  slot *bucket_of(const hash_t &) const;
+  bool read(const slot &, snapshot &) const;
+  bool valid(const snapshot &) const;
+  static fitness_t to_fitness(const snapshot &);
+  bool store(const hash_t &, const fitness_t &);
+
+  const std::uint64_t k_mask;
+  std::unique_ptr<slot[]> table_;
+
+  std::atomic<std::uint32_t> seal_;
+  std::atomic<std::uint32_t> tick_;
+
+  mutable std::atomic<std::uint64_t> hits_, misses_;
+  std::atomic<std::uint64_t> evictions_, collisions_;
+};
+
+}  // namespace vita
+
+#endif  // include guard
@@ -15,7 +15,9 @@
 
 #include <fstream>
 
+#include "kernel/cache_hash.h"
 #include "kernel/environment.h"
+#include "kernel/fitness.h"
 #include "kernel/log.h"
 #include "kernel/problem.h"
 #include "kernel/random.h"
@@ -32,6 +34,9 @@ namespace vita
 /// population is organized in one or more layers that can interact in
 /// many ways (depending on the evolution strategy).
 ///
+/// The population also remembers the fitness of its individuals, so that
+/// scoring an individual already evaluated doesn't require the evaluator.
+///
 template<class T>
 class population
 {
@@ -57,6 +62,12 @@ public:
 
   void inc_age();
 
+  const fitness_t *stored_fitness(coord) const;
+  void store_fitness(coord, const fitness_t &);
+  void clear_fitness();
+  template<class E> fitness_t fitness(coord, E &) const;
+  template<class E> void evaluate(E &);
+
   const problem &get_problem() const;
 
   bool is_valid() const;
@@ -74,11 +85,27 @@ public:
   bool save(std::ostream &) const;
 
 private:
+  struct known_fitness
+  {
+    /// Signature of the evaluated individual.
+    hash_t signature;
+    /// Value of `epoch_` at evaluation time.
+    unsigned epoch;
+    fitness_t fitness;
+  };
 
   const problem *prob_;
 
   std::vector<layer_t> pop_;
   std::vector<unsigned> allowed_;
+
+  // Fitness of the individuals (one vector per layer, indexed as `pop_`). An
+  // element is up to date only if it has the signature of the individual
+  // currently at the same coordinates and the current epoch: assignments to
+  // `operator[]` and changes of the training data (see `clear_fitness`) are
+  // detected without further bookkeeping.
+  std::vector<std::vector<known_fitness>> fit_;
+  unsigned epoch_;
 };
 
 template<class T> typename population<T>::coord pickup(const population<T> &);
@@ -24,7 +24,7 @@
 ///
 template<class T>
 population<T>::population(const problem &p) : prob_(&p), pop_(1),
-                                              allowed_(1)
+                                              allowed_(1), fit_(1), epoch_(0)
 {
   const auto n(p.env.individuals);
   pop_[0].reserve(n);
@@ -48,6 +48,7 @@ void population<T>::init_layer(unsigned l)
   Expects(l < layers());
 
   pop_[l].clear();
+  fit_[l].clear();
 
   std::generate_n(std::back_inserter(pop_[l]), allowed(l),
                   [this] {return T(get_problem()); });
@@ -83,6 +84,7 @@ void population<T>::add_layer()
   pop_[0].reserve(individuals);
 
   allowed_.insert(allowed_.begin(), individuals);
+  fit_.emplace(fit_.begin());
 
   init_layer(0);
 }
@@ -94,6 +96,7 @@ void population<T>::remove_layer(unsigned l)
 
   pop_.erase(std::next(pop_.begin(), l));
   allowed_.erase(std::next(allowed_.begin(), l));
+  fit_.erase(std::next(fit_.begin(), l));
 }
 
 ///
@@ -264,6 +267,96 @@ void population<T>::inc_age()
       i.inc_age();
 }
 
+///
+/// \param[in] c coordinates of an individual
+/// \return      a pointer to the stored fitness of the individual at
+///              coordinates `c` or `nullptr` if it isn't known / up to date
+///
+template<class T>
+const fitness_t *population<T>::stored_fitness(coord c) const
+{
+  Expects(c.layer < layers());
+  Expects(c.index < individuals(c.layer));
+
+  const auto &layer(fit_[c.layer]);
+  if (c.index >= layer.size())
+    return nullptr;
+
+  const auto &kf(layer[c.index]);
+  if (kf.epoch != epoch_
+      || kf.signature != pop_[c.layer][c.index].signature())
+    return nullptr;
+
+  return &kf.fitness;
+}
+
+///
+/// Stores the fitness of an individual.
+///
+/// \param[in] c coordinates of an individual
+/// \param[in] f the fitness of the individual at coordinates `c`
+///
+/// \remark
+/// Different layers can be updated concurrently.
+///
+template<class T>
+void population<T>::store_fitness(coord c, const fitness_t &f)
+{
+  Expects(c.layer < layers());
+  Expects(c.index < individuals(c.layer));
+
+  auto &layer(fit_[c.layer]);
+  if (c.index >= layer.size())
+    layer.resize(allowed(c.layer));
+
+  layer[c.index] = {pop_[c.layer][c.index].signature(), epoch_, f};
+}
+
+///
+/// Marks every stored fitness as outdated.
+///
+/// Required when the evaluator changes (e.g. training data are modified by
+/// DSS).
+///
+template<class T>
+void population<T>::clear_fitness()
+{
+  ++epoch_;
+}
+
+///
+/// \param[in] c   coordinates of an individual
+/// \param[in] eva evaluator used when the fitness isn't stored
+/// \return        the fitness of the individual at coordinates `c`
+///
+/// \remark
+/// The population isn't changed, so concurrent calls are safe.
+///
+template<class T>
+template<class E>
+fitness_t population<T>::fitness(coord c, E &eva) const
+{
+  if (const auto *f = stored_fitness(c))
+    return *f;
+
+  return eva(operator[](c));
+}
+
+///
+/// Evaluates the individuals whose fitness isn't known.
+///
+/// \param[in] eva evaluator
+///
+template<class T>
+template<class E>
+void population<T>::evaluate(E &eva)
+{
+  for (unsigned l(0); l < layers(); ++l)
+    for (unsigned i(0); i < individuals(l); ++i)
+      if (!stored_fitness({l, i}))
+        store_fitness({l, i}, eva(pop_[l][i]));
+}
+
 ///
 /// \return `true` if the object passes the internal consistency check
 ///
@@ -281,6 +374,12 @@ bool population<T>::is_valid() const
     return false;
   }
 
+  if (layers() != fit_.size())
+  {
+    vitaERROR << "Number of layers doesn't match fitness array size";
+    return false;
+  }
+
   const auto n(layers());
   for (auto l(decltype(n){0}); l < n; ++l)
   {
@@ -19,12 +19,17 @@ namespace random
 {
 
 ///
-/// The shared random engine generator.
+/// The random engine generator.
 ///
 /// The numbers produced will be the same every time the program is run.
 /// Use the `randomize` / `seed` functions for randomization.
 ///
-engine_t engine;
+/// \remark
+/// Every thread has its own engine: concurrent workers don't contend for (and
+/// don't corrupt) a shared state. A newly created thread starts with a default
+/// seeded engine so the spawning thread should seed / assign it.
+///
+thread_local engine_t engine;
 
 ///
 /// Initalizes the random number generator.
@@ -45,7 +50,7 @@ void seed(unsigned s)
 }
 
 ///
-/// Sets the shared engine to an unpredictable state.
+/// Sets the engine (of the calling thread) to an unpredictable state.
 ///
 void randomize()
 {
@@ -53,6 +58,39 @@ void randomize()
   seed(rd());
 }
 
+///
+/// Splits the random sequence into many independent streams.
+///
+/// \param[in] n number of streams required
+/// \return      `n` engines producing non-overlapping sequences
+///
+/// Streams are obtained from the engine of the calling thread via
+/// `engine_t::jump()`. The engine is then advanced with
+/// `engine_t::long_jump()`, so subsequent calls give new streams.
+///
+/// The result only depends on the state of the engine of the calling thread:
+/// given the seed, concurrent workers assigning `streams(n)[i]` to their
+/// `engine` produce a reproducible output.
+///
+std::vector<engine_t> streams(unsigned n)
+{
+  Expects(n);
+
+  std::vector<engine_t> ret;
+  ret.reserve(n);
+
+  auto e(engine);
+  for (unsigned i(0); i < n; ++i)
+  {
+    e.jump();
+    ret.push_back(e);
+  }
+
+  engine.long_jump();
+
+  return ret;
+}
+
 ///
 /// Returns a random number in a modular arithmetic system.
 ///
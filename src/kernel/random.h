@@ -15,6 +15,7 @@
 
 #include <cstdlib>
 #include <random>
+#include <vector>
 
 #include "kernel/common.h"
 #include "kernel/range.h"
@@ -33,7 +34,7 @@ enum class distribution {uniform, normal};
 ///
 using engine_t = vigna::xoshiro256ss;
 
-extern engine_t engine;
+extern thread_local engine_t engine;
 
 template<class T> [[nodiscard]] T sup(T);
 
@@ -44,6 +45,8 @@ template<class T> [[nodiscard]] T sup(T);
 void seed(unsigned);
 void randomize();
 
+[[nodiscard]] std::vector<engine_t> streams(unsigned);
+
 ///
 /// Used for ephemeral random constant generation.
 ///
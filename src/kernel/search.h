@@ -110,6 +110,7 @@ protected:
 
 private:
   void log_stats(const search_stats<T> &) const;
+  std::vector<summary<T>> run_concurrently(unsigned, unsigned);
   bool load();
   bool save() const;
 };
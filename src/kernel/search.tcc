@@ -176,26 +176,89 @@ void search<T, ES>::after_evolution(const summary<T> &s)
   print_resume(s.best.score);
 }
 
+///
+/// Performs many runs at the same time.
+///
+/// \param[in] n       number of runs
+/// \param[in] threads number of runs performed at the same time
+/// \return            the summaries of the runs (in run order)
+///
+/// Every run has its own population and uses its own random stream (see
+/// `random::streams`): the result of run `r` only depends on the random seed
+/// and on `r`.
+///
+/// \remark
+/// - The after generation callback is called from many threads.
+/// - Runs share the evaluator and the training data. The evaluator is used
+///   in read-only mode (see `evaluator::read_only`) and only validation
+///   strategies never changing the training data during the evolution are
+///   allowed (e.g. not DSS, that uses the difficulty of the examples).
+///
+template<class T, template<class> class ES>
+std::vector<summary<T>> search<T, ES>::run_concurrently(unsigned n,
+                                                        unsigned threads)
+{
+  Expects(threads > 1);
+  Expects(vs_->is_concurrent());
+
+  for (unsigned r(0); r < n; ++r)
+    vs_->init(r);
+
+  auto shake([this](unsigned g) { return vs_->shake(g); });
+
+  // Runs share the evaluator, that mustn't change the training data.
+  const bool read_only(eva1_->read_only());
+  eva1_->read_only(true);
+
+  const auto engines(random::streams(n));
+  std::vector<summary<T>> ret(n);
+  std::atomic<unsigned> next(0);
+
+  const auto worker([&]
+  {
+    for (auto r(next++); r < n; r = next++)
+    {
+      random::engine = engines[r];
+      ret[r] = evolution<T, ES>(prob_, *eva1_)
+               .after_generation(after_generation_callback_)
+               .concurrent(vs_->is_concurrent())
+               .run(r, shake);
+    }
+  });
+
+  std::vector<std::future<void>> workers;
+  for (unsigned w(0); w < threads; ++w)
+    workers.push_back(std::async(std::launch::async, worker));
+
+  for (auto &w : workers)
+    w.get();
+
+  eva1_->read_only(read_only);
+
+  for (unsigned r(0); r < n; ++r)
+    vs_->close(r);
+
+  return ret;
+}
+
 ///
 /// \param[in] n number of runs
 /// \return      a summary of the search
 ///
+/// When `environment::concurrent_runs > 1` (and the validation strategy
+/// supports it) runs are performed at the same time (see `run_concurrently`).
+/// Run summaries are then processed (metrics, logging...) in run order, so
+/// the search statistics don't depend on the scheduling.
+///
 template<class T, template<class> class ES>
 summary<T> search<T, ES>::run(unsigned n)
 {
   init();
 
-  auto shake([this](unsigned g) { return vs_->shake(g); });
   search_stats<T> stats;
 
-  for (unsigned r(0); r < n; ++r)
+  const auto after_run([&](summary<T> &run_summary)
   {
-    vs_->init(r);
-    auto run_summary(evolution<T, ES>(prob_, *eva1_)
-                     .after_generation(after_generation_callback_)
-                     .run(r, shake));
-    vs_->close(r);
-
     // Possibly calculates additional metrics.
     calculate_metrics(&run_summary);
 
@@ -203,6 +266,33 @@ summary<T> search<T, ES>::run(unsigned n)
 
     stats.update(run_summary);
     log_stats(stats);
+  });
+
+  auto threads(std::min(prob_.env.concurrent_runs, n));
+  if (threads > 1 && !vs_->is_concurrent())
+  {
+    vitaWARNING << "Validation strategy doesn't support concurrent runs";
+    threads = 1;
+  }
+
+  if (threads > 1)
+    for (auto &run_summary : run_concurrently(n, threads))
+      after_run(run_summary);
+  else
+  {
+    auto shake([this](unsigned g) { return vs_->shake(g); });
+
+    for (unsigned r(0); r < n; ++r)
+    {
+      vs_->init(r);
+      auto run_summary(evolution<T, ES>(prob_, *eva1_)
+                       .after_generation(after_generation_callback_)
+                       .concurrent(vs_->is_concurrent())
+                       .run(r, shake));
+      vs_->close(r);
+
+      after_run(run_summary);
+    }
   }
 
   close();
@@ -312,13 +402,27 @@ void search<T, ES>::print_resume(const model_measurements &m) const
 /// changes in the training simulation / set should invalidate fitness values
 /// stored in that cache.
 ///
+/// \remark
+/// With concurrent evolution or concurrent runs (`environment::threads`,
+/// `environment::concurrent_runs`) the cache is a `lockfree_cache`. These
+/// parameters must be set before calling this function.
+///
 template<class T, template<class> class ES>
 template<class E, class... Args>
 search<T, ES> &search<T, ES>::training_evaluator(Args && ...args)
 {
   if (prob_.env.cache_size)
-    eva1_ = std::make_unique<evaluator_proxy<T, E>>(
-      E(std::forward<Args>(args)...), prob_.env.cache_size);
+  {
+    // Concurrent evaluations would serialise on the lock of `cache`.
+    if (prob_.env.threads > 1 || prob_.env.concurrent_runs > 1)
+      eva1_ = std::make_unique<evaluator_proxy<T, E, lockfree_cache>>(
+        E(std::forward<Args>(args)...), prob_.env.cache_size,
+        prob_.env.semantic_cache);
+    else
+      eva1_ = std::make_unique<evaluator_proxy<T, E>>(
+        E(std::forward<Args>(args)...), prob_.env.cache_size,
+        prob_.env.semantic_cache);
+  }
   else
     eva1_ = std::make_unique<E>(std::forward<Args>(args)...);
 
@@ -422,6 +526,18 @@ void search<T, ES>::log_stats(const search_stats<T> &stats,
                                  : 0);
   set_text(e_solutions, "avg_depth", avg_depth);
 
+  if (eva1_)
+    if (const auto cs = eva1_->cache_stats())
+    {
+      auto *e_cache(d->NewElement("cache"));
+      e_summary->InsertEndChild(e_cache);
+      set_text(e_cache, "hits", cs->hits);
+      set_text(e_cache, "misses", cs->misses);
+      set_text(e_cache, "evictions", cs->evictions);
+      set_text(e_cache, "collisions", cs->collisions);
+      set_text(e_cache, "hit_rate", cs->hit_rate());
+    }
+
   auto *e_other(d->NewElement("other"));
   e_summary->InsertEndChild(e_other);
 
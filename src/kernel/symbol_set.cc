@@ -11,6 +11,7 @@
  */
 
 #include <set>
+#include <stdexcept>
 
 #include "kernel/symbol_set.h"
 #include "kernel/log.h"
@@ -52,11 +53,20 @@ void symbol_set::clear()
 /// A symbol with undefined category will be changed to the first free
 /// category.
 ///
+/// \exception std::invalid_argument function with more than `gene::k_args`
+///                                  arguments
+///
+/// \note
+/// Functions can have up to `gene::k_args` arguments.
+///
 symbol *symbol_set::insert(std::unique_ptr<symbol> s, double wr)
 {
   Expects(s);
   Expects(wr >= 0.0);
 
+  if (s->arity() > gene::k_args)
+    throw std::invalid_argument("Too many arguments for a function");
+
   const auto w(static_cast<weight_t>(wr * w_symbol::base_weight));
   const w_symbol ws(s.get(), w);
 
@@ -47,6 +47,18 @@ public:
   ///
   /// \note Called at the end of the evolution (one time per run).
   virtual void close(unsigned /* run */) {}
+
+  /// \return `true` if many runs (or workers) can share the training
+  ///         environment
+  ///
+  /// When `true`, `shake` must never change the training environment and
+  /// `init` / `close` can be called, in run order, for all the runs before /
+  /// after they're performed (see `environment::concurrent_runs`). When
+  /// `false`, also the evolution uses a single worker (see
+  /// `environment::threads`).
+  ///
+  /// By default returns `false`.
+  virtual bool is_concurrent() const { return false; }
 };
 
 ///
@@ -61,6 +73,7 @@ class as_is_validation final : public validation_strategy
 {
 public:
   void init(unsigned) override {}
+  bool is_concurrent() const override { return true; }
 };
 
 }  // namespace vita
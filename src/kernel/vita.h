@@ -30,6 +30,7 @@
 #include "kernel/gp/src/primitive/int.h"
 #include "kernel/gp/src/primitive/real.h"
 #include "kernel/gp/src/primitive/string.h"
+#include "kernel/gp/src/streamed_dataframe.h"
 #include "kernel/gp/src/variable.h"
 #include "kernel/gp/team.h"
 #include "utility/pocket_csv.h"
@@ -38,6 +38,7 @@ template<class T,
          template<class> class RS> class evolution_strategy;
 template<class T, template<class> class CS> class basic_alps_es;
 template<class T> class std_es;
+template<class T> class island_es;
 
 template<class T, template<class> class ES> class src_search;
 
@@ -0,0 +1,671 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2024 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#include <fstream>
+#include <numeric>
+
+#include "kernel/evaluator_proxy.h"
+#include "kernel/gp/src/batch_interpreter.h"
+#include "kernel/gp/src/evaluator.h"
+#include "kernel/gp/src/interpreter.h"
+#include "kernel/gp/src/problem.h"
+#include "kernel/gp/src/streamed_dataframe.h"
+#include "kernel/gp/team.h"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "third_party/doctest/doctest.h"
+
+struct fixture_batch
+{
+  fixture_batch() : pr()
+  {
+    pr.env.init();
+
+    pr.data().read("./test_resources/mep.csv");
+    pr.setup_symbols();
+
+    // Enough examples to fill more than one block.
+    const std::vector<vita::dataframe::example> base(pr.data().begin(),
+                                                     pr.data().end());
+    while (pr.data().size() < 3 * vita::batch_interpreter::block_size)
+      for (const auto &e : base)
+        pr.data().push_back(e);
+  }
+
+  vita::src_problem pr;
+};
+
+TEST_SUITE("BATCH INTERPRETER")
+{
+
+TEST_CASE_FIXTURE(fixture_batch, "Same output of the scalar interpreter")
+{
+  using namespace vita;
+
+  for (unsigned k(0); k < 1000; ++k)
+  {
+    const i_mep ind(pr);
+    batch_interpreter bi(&ind);
+    src_interpreter<i_mep> si(&ind);
+
+    std::vector<dataframe::example *> block;
+    std::size_t n(0);
+    for (auto &e : pr.data())
+    {
+      block.push_back(&e);
+
+      if (++n == pr.data().size()
+          || block.size() == batch_interpreter::block_size)
+      {
+        bi.run(block);
+
+        for (std::size_t i(0); i < block.size(); ++i)
+          CHECK(bi[i] == si.run(block[i]->input));
+
+        block.clear();
+      }
+    }
+  }
+}
+
+TEST_CASE_FIXTURE(fixture_batch, "Bytecode")
+{
+  using namespace vita;
+
+  // The tree-walking interpreter with input variables.
+  class tree_interpreter : public interpreter<i_mep>
+  {
+  public:
+    using interpreter<i_mep>::interpreter;
+
+    value_t run(const std::vector<value_t> &ex)
+    {
+      ex_ = &ex;
+      return interpreter<i_mep>::run();
+    }
+
+    value_t fetch_var(unsigned i) final { return (*ex_)[i]; }
+
+  private:
+    const std::vector<value_t> *ex_ = nullptr;
+  };
+
+  const dataframe::columnar columnar(pr.data());
+
+  for (unsigned k(0); k < 1000; ++k)
+  {
+    const i_mep ind(pr);
+    const bytecode bc(ind);
+    CHECK(bc.size() == ind.active_symbols());
+    CHECK(bc.real());
+
+    tree_interpreter ti(&ind);
+    src_interpreter<i_mep> si(&ind);
+    bytecode::registers reg;
+
+    std::size_t row(0);
+    for (const auto &e : pr.data())
+    {
+      const auto expected(ti.run(e.input));
+
+      CHECK(bc.run(reg, e.input) == expected);
+      CHECK(bc.run(reg, columnar, row) == expected);
+      CHECK(si.run(e.input) == expected);
+
+      // An empty input value forces the fallback to the `value_t` path.
+      auto partial(e.input);
+      partial[random::sup(partial.size())] = {};
+      CHECK(bc.run(reg, partial) == ti.run(partial));
+
+      ++row;
+    }
+  }
+}
+
+TEST_CASE_FIXTURE(fixture_batch, "Same fitness of the scalar path")
+{
+  using namespace vita;
+
+  mae_evaluator<i_mep> mae(pr.data());
+  mse_evaluator<i_mep> mse(pr.data());
+  rmae_evaluator<i_mep> rmae(pr.data());
+  count_evaluator<i_mep> count(pr.data());
+
+  const auto scalar([this](const auto &err_fctr)
+  {
+    double average_error(0.0), n(0.0);
+    for (const auto &e : pr.data())
+      average_error += (err_fctr(e) - average_error) / ++n;
+
+    return fitness_t{-average_error};
+  });
+
+  for (unsigned k(0); k < 1000; ++k)
+  {
+    const i_mep ind(pr);
+
+    CHECK(mae(ind) == scalar(mae_error_functor<i_mep>(ind)));
+    CHECK(mse(ind) == scalar(mse_error_functor<i_mep>(ind)));
+    CHECK(rmae(ind) == scalar(rmae_error_functor<i_mep>(ind)));
+    CHECK(count(ind) == scalar(count_error_functor<i_mep>(ind)));
+  }
+}
+
+TEST_CASE_FIXTURE(fixture_batch, "Columnar dataframe")
+{
+  using namespace vita;
+
+  dataframe::columnar cd(pr.data());
+  REQUIRE(cd.size() == pr.data().size());
+
+  using columnar_mae = sum_of_errors_evaluator<i_mep, mae_error_functor<i_mep>,
+                                               dataframe::columnar>;
+  mae_evaluator<i_mep> row_mae(pr.data());
+  columnar_mae col_mae(cd);
+
+  for (unsigned k(0); k < 1000; ++k)
+  {
+    const i_mep ind(pr);
+    batch_interpreter bi(&ind);
+    src_interpreter<i_mep> si(&ind);
+
+    for (std::size_t step(1); step <= 3; step += 2)
+      for (std::size_t first(0); first < cd.size();
+           first += batch_interpreter::block_size * step)
+      {
+        const auto n(std::min(batch_interpreter::block_size,
+                              (cd.size() - first + step - 1) / step));
+        bi.run(cd, first, n, step);
+
+        for (std::size_t i(0); i < n; ++i)
+        {
+          const auto row(first + i * step);
+          CHECK(bi[i] == si.run(cd.row(row)));
+          CHECK(si.run(cd, row) == bi[i]);
+        }
+      }
+
+    CHECK(col_mae(ind) == row_mae(ind));
+    CHECK(col_mae.fast(ind) == row_mae.fast(ind));
+  }
+
+  // Difficulty is updated like in the row-oriented dataframe.
+  auto e(pr.data().begin());
+  for (std::size_t i(0); i < cd.size(); ++i, ++e)
+    CHECK(cd.difficulty[i] == e->difficulty);
+}
+
+TEST_CASE_FIXTURE(fixture_batch, "Streamed dataframe")
+{
+  using namespace vita;
+
+  // The examples of the fixture stored in a file.
+  std::string text;
+  std::ifstream in("./test_resources/mep.csv");
+  for (std::string line; std::getline(in, line);)
+    if (!line.empty())
+      text += line + '\n';
+
+  const std::size_t lines(std::count(text.begin(), text.end(), '\n'));
+  REQUIRE(pr.data().size() % lines == 0);
+
+  const auto fn(std::filesystem::temp_directory_path() / "vita_streamed.csv");
+  {
+    std::ofstream out(fn);
+    for (std::size_t i(0); i < pr.data().size() / lines; ++i)
+      out << text;
+  }
+
+  dataframe::params p;
+  p.dialect.delimiter = ',';
+  p.dialect.has_header = pocket_csv::dialect::NO_HEADER;
+
+  using streamed_mae = sum_of_errors_evaluator<i_mep, mae_error_functor<i_mep>,
+                                               streamed_dataframe>;
+  using streamed_mse = sum_of_errors_evaluator<i_mep, mse_error_functor<i_mep>,
+                                               streamed_dataframe>;
+  mae_evaluator<i_mep> row_mae(pr.data());
+  mse_evaluator<i_mep> row_mse(pr.data());
+
+  // Blocks smaller / larger than the examples used for the metadata and than
+  // the block of the batch interpreter.
+  for (std::size_t block : {7, 100, 1000})
+  {
+    streamed_dataframe sd(fn, p, block);
+    CHECK(sd.block_size() == block);
+    CHECK(sd.variables() == pr.data().variables());
+
+    CHECK(std::equal(sd.begin(), sd.end(),
+                     pr.data().begin(), pr.data().end(),
+                     [](const auto &e1, const auto &e2)
+                     {
+                       return e1.input == e2.input && e1.output == e2.output;
+                     }));
+
+    streamed_mae s_mae(sd);
+    streamed_mse s_mse(sd);
+
+    for (unsigned k(0); k < 50; ++k)
+    {
+      const i_mep ind(pr);
+
+      CHECK(s_mae(ind)[0] == doctest::Approx(row_mae(ind)[0]));
+      CHECK(s_mse(ind)[0] == doctest::Approx(row_mse(ind)[0]));
+      CHECK(s_mae.fast(ind)[0] == doctest::Approx(row_mae.fast(ind)[0]));
+    }
+  }
+
+  std::filesystem::remove(fn);
+}
+
+TEST_CASE_FIXTURE(fixture_batch, "Data parallel evaluation")
+{
+  using namespace vita;
+
+  // More than one partition.
+  const std::vector<dataframe::example> base(pr.data().begin(),
+                                             pr.data().end());
+  while (pr.data().size() < 3 * mae_evaluator<i_mep>::partition_size + 100)
+    for (const auto &e : base)
+      pr.data().push_back(e);
+
+  dataframe copy(pr.data());
+
+  mae_evaluator<i_mep> mae(pr.data()), par_mae(copy);
+  mse_evaluator<i_mep> mse(pr.data()), par_mse(copy);
+  mae_evaluator<team<i_mep>> team_mae(pr.data()), par_team_mae(copy);
+
+  CHECK(!mae.data_parallel());
+  par_mae.data_parallel(true);
+  par_mse.data_parallel(true);
+  par_team_mae.data_parallel(true);
+  CHECK(par_mae.data_parallel());
+
+  for (unsigned k(0); k < 100; ++k)
+  {
+    const i_mep ind(pr);
+    const team<i_mep> t(pr);
+
+    CHECK(par_mae(ind)[0] == doctest::Approx(mae(ind)[0]));
+    CHECK(par_mse(ind)[0] == doctest::Approx(mse(ind)[0]));
+    CHECK(par_mae.fast(ind)[0] == doctest::Approx(mae.fast(ind)[0]));
+    CHECK(par_team_mae(t)[0] == doctest::Approx(team_mae(t)[0]));
+  }
+
+  // Same difficulties of the sequential evaluation.
+  CHECK(std::equal(pr.data().begin(), pr.data().end(), copy.begin(),
+                   [](const auto &e1, const auto &e2)
+                   {
+                     return e1.difficulty == e2.difficulty;
+                   }));
+}
+
+TEST_CASE_FIXTURE(fixture_batch, "Read-only evaluation")
+{
+  using namespace vita;
+
+  mae_evaluator<i_mep> mae(pr.data());
+  CHECK(!mae.read_only());
+
+  evaluator_proxy<i_mep, mae_evaluator<i_mep>> proxy(mae, 16);
+  proxy.read_only(true);
+  CHECK(proxy.read_only());
+
+  const auto difficulty([&]
+  {
+    return std::accumulate(pr.data().begin(), pr.data().end(),
+                           std::uintmax_t(0),
+                           [](std::uintmax_t sum, const auto &e)
+                           {
+                             return sum + e.difficulty;
+                           });
+  });
+
+  const auto before(difficulty());
+
+  for (unsigned k(0); k < 100; ++k)
+    static_cast<void>(proxy(i_mep(pr)));
+
+  // In read-only mode the training data isn't changed.
+  CHECK(difficulty() == before);
+
+  for (unsigned k(0); k < 100; ++k)
+    static_cast<void>(mae(i_mep(pr)));
+
+  CHECK(difficulty() > before);
+}
+
+TEST_CASE_FIXTURE(fixture_batch, "Racing evaluation")
+{
+  using namespace vita;
+
+  mae_evaluator<i_mep> mae(pr.data());
+  mae_evaluator<team<i_mep>> team_mae(pr.data());
+  evaluator_proxy<i_mep, mae_evaluator<i_mep>> proxy(mae, 10);
+
+  const auto check([](auto &eva, const auto &prg, const fitness_t &bound)
+  {
+    const auto r(eva.race(prg, bound));
+    const auto f(eva(prg));
+
+    if (r.exact)
+      CHECK(r.fitness == f);
+    else
+    {
+      // An interrupted evaluation returns an upper bound of the fitness.
+      CHECK(r.fitness <= bound);
+      CHECK(f <= r.fitness);
+    }
+
+    return r.exact;
+  });
+
+  unsigned interrupted(0);
+  for (unsigned k(0); k < 1000; ++k)
+  {
+    const i_mep ind(pr), rival(pr);
+    const team<i_mep> t(pr), t_rival(pr);
+
+    interrupted += !check(mae, ind, mae(rival));
+    interrupted += !check(team_mae, t, team_mae(t_rival));
+
+    // Without a bound the evaluation is complete.
+    CHECK(mae.race(ind, {}).exact);
+
+    // Interrupted evaluations aren't cached.
+    if (const auto r = proxy.race(ind, mae(rival)); !r.exact)
+      CHECK(proxy(ind) == mae(ind));
+  }
+
+  CHECK(interrupted > 0);
+}
+
+TEST_CASE_FIXTURE(fixture_batch, "Semantic cache")
+{
+  using namespace vita;
+
+  mae_evaluator<i_mep> mae(pr.data());
+  mae_evaluator<team<i_mep>> team_mae(pr.data());
+
+  const i_mep ind(pr);
+  CHECK(!mae.fingerprint(ind, 10).empty());
+  CHECK(mae.fingerprint(ind, 10) == mae.fingerprint(ind, 10));
+  CHECK(mae.fingerprint(ind, 0).empty());
+  CHECK(team_mae.fingerprint(team<i_mep>(pr), 10).empty());
+
+  CHECK(!evaluator_proxy<i_mep, mae_evaluator<i_mep>>(mae, 10)
+         .semantic_stats());
+
+  // Probing the whole dataset, programs with the same fingerprint have the
+  // same fitness.
+  environment::semantic_cache_parameters sp;
+  sp.probes = static_cast<unsigned>(pr.data().size());
+  sp.verification = 0.0;
+  evaluator_proxy<i_mep, mae_evaluator<i_mep>> proxy(mae, 16, sp);
+
+  for (unsigned k(0); k < 2000; ++k)
+  {
+    const i_mep prg(pr);
+
+    const auto hits(proxy.semantic_stats()->hits);
+    CHECK(proxy(prg) == mae(prg));
+
+    // Semantic hits are stored under the signature of the program.
+    if (proxy.semantic_stats()->hits > hits)
+    {
+      CHECK(proxy(prg) == mae(prg));
+      CHECK(proxy.semantic_stats()->hits == hits + 1);
+    }
+
+    CHECK(proxy.race(i_mep(pr), {}).exact);
+  }
+
+  // A semantic hit proving that a program cannot beat the bound is
+  // reported as an interrupted evaluation.
+  for (unsigned k(0); k < 2000; ++k)
+  {
+    const i_mep prg(pr);
+
+    const auto hits(proxy.semantic_stats()->hits);
+    const auto r(proxy.race(prg, fitness_t{0.0}));
+    if (proxy.semantic_stats()->hits > hits)
+      CHECK(!r.exact);
+  }
+
+  const auto stats(proxy.semantic_stats());
+  REQUIRE(stats);
+  CHECK(stats->hits > 0);
+
+  proxy.clear();
+  CHECK(proxy.semantic_stats()->hits == stats->hits);
+
+  // The verification of the hits doesn't use the random engine.
+  sp.verification = 0.5;
+  evaluator_proxy<i_mep, mae_evaluator<i_mep>> proxy2(mae, 16, sp);
+
+  std::vector<i_mep> programs;
+  for (unsigned k(0); k < 2000; ++k)
+    programs.emplace_back(pr);
+
+  const auto engine(random::engine);
+  for (const auto &prg : programs)
+    CHECK(proxy2(prg) == mae(prg));
+  CHECK(random::engine == engine);
+}
+
+TEST_CASE("Column cache")
+{
+  using namespace vita;
+
+  column_cache cc(2);
+  CHECK(cc.capacity() == 2);
+  CHECK(cc.size() == 0);
+
+  std::vector<D_DOUBLE> val(4);
+  std::vector<real::mask_t> ok(4);
+  const auto fill([&](double v)
+  {
+    std::fill(val.begin(), val.end(), v);
+    std::fill(ok.begin(), ok.end(), true);
+    ok[1] = false;
+  });
+
+  const hash_t block(1, 2);
+  const auto k1(column_cache::key(hash_t(3, 4), block));
+  const auto k2(column_cache::key(hash_t(5, 6), block));
+  const auto k3(column_cache::key(hash_t(3, 4), hash_t(7, 8)));
+  CHECK(k1 != k2);
+  CHECK(k1 != k3);
+
+  fill(1.0);
+  cc.insert(k1, {val.data(), ok.data()}, val.size());
+  fill(2.0);
+  cc.insert(k2, {val.data(), ok.data()}, val.size());
+  CHECK(cc.size() == 2);
+
+  // `k1` becomes the most recently used column...
+  fill(0.0);
+  CHECK(cc.find(k1, {val.data(), ok.data()}, val.size()));
+  CHECK(val[0] == doctest::Approx(1.0));
+  CHECK(ok[0]);
+  CHECK(!ok[1]);
+
+  // ... so `k2` is evicted.
+  cc.insert(k3, {val.data(), ok.data()}, val.size());
+  CHECK(cc.size() == 2);
+  CHECK(!cc.find(k2, {val.data(), ok.data()}, val.size()));
+  CHECK(cc.find(k1, {val.data(), ok.data()}, val.size()));
+
+  // Columns of a different length aren't returned.
+  CHECK(!cc.find(k1, {val.data(), ok.data()}, 3));
+
+  const auto stats(cc.stats());
+  CHECK(stats.hits == 2);
+  CHECK(stats.misses == 2);
+  CHECK(stats.evictions == 1);
+
+  cc.capacity(1);
+  CHECK(cc.size() == 1);
+
+  cc.clear();
+  CHECK(cc.size() == 0);
+}
+
+TEST_CASE_FIXTURE(fixture_batch, "Subtree cache")
+{
+  using namespace vita;
+
+  const dataframe::columnar columnar(pr.data());
+  std::vector<dataframe::example *> block;
+  for (auto &e : pr.data())
+    if (block.size() < batch_interpreter::block_size)
+      block.push_back(&e);
+
+  column_cache cc(10000);
+
+  for (unsigned k(0); k < 200; ++k)
+  {
+    const i_mep parent(pr), other(pr);
+    auto offspring(crossover(parent, other));
+    offspring.mutation(0.1, pr);
+
+    for (const i_mep *prg : std::vector<const i_mep *>{&parent, &offspring})
+    {
+      batch_interpreter plain(prg), cached(prg, &cc);
+
+      plain.run(block);
+      cached.run(block, pr.data().version());
+      for (std::size_t i(0); i < block.size(); ++i)
+        CHECK(cached[i] == plain[i]);
+
+      plain.run(columnar, 3, 100, 2);
+      cached.run(columnar, 3, 100, 2);
+      for (std::size_t i(0); i < 100; ++i)
+        CHECK(cached[i] == plain[i]);
+    }
+  }
+
+  CHECK(cc.stats().hits > 0);
+
+  // A new version of the dataset doesn't get the columns of the old one, even
+  // if its examples have the same addresses.
+  const std::vector<dataframe::example> original(pr.data().begin(),
+                                                 pr.data().end());
+  std::vector<i_mep> programs;
+  for (unsigned k(0); k < 50; ++k)
+  {
+    programs.emplace_back(pr);
+
+    batch_interpreter cached(&programs.back(), &cc);
+    cached.run(block, pr.data().version());
+  }
+
+  const auto old_version(pr.data().version());
+  pr.data().clear();
+  for (auto e : original)
+  {
+    for (auto &x : e.input)
+      if (std::holds_alternative<D_DOUBLE>(x))
+        x = 2.0 * std::get<D_DOUBLE>(x) + 1.0;
+
+    pr.data().push_back(e);
+  }
+  CHECK(pr.data().version() != old_version);
+  REQUIRE(&*pr.data().begin() == block.front());
+
+  for (const auto &prg : programs)
+  {
+    batch_interpreter plain(&prg), cached(&prg, &cc);
+
+    plain.run(block);
+    cached.run(block, pr.data().version());
+    for (std::size_t i(0); i < block.size(); ++i)
+      CHECK(cached[i] == plain[i]);
+  }
+
+  // Same fitness with the cache enabled.
+  mae_evaluator<i_mep> mae(pr.data());
+  mae_evaluator<i_mep> mae_cached(pr.data());
+  CHECK(!mae_cached.subtree_cache_stats());
+  mae_cached.subtree_cache(10000);
+
+  for (unsigned k(0); k < 200; ++k)
+  {
+    const i_mep parent(pr), other(pr);
+    const auto offspring(crossover(parent, other));
+
+    CHECK(mae_cached(parent) == mae(parent));
+    CHECK(mae_cached(offspring) == mae(offspring));
+  }
+
+  const auto stats(mae_cached.subtree_cache_stats());
+  REQUIRE(stats);
+  CHECK(stats->hits > 0);
+
+  mae_cached.subtree_cache(0);
+  CHECK(!mae_cached.subtree_cache_stats());
+}
+
+TEST_CASE("Data parallel classification")
+{
+  using namespace vita;
+
+  const auto test([](const std::string &file, auto make_evaluators)
+  {
+    src_problem pr;
+    pr.env.init();
+
+    pr.data().read("./test_resources/" + file);
+    pr.setup_symbols();
+
+    const std::vector<dataframe::example> base(pr.data().begin(),
+                                               pr.data().end());
+    while (pr.data().size() < 2 * src_evaluator<i_mep>::partition_size + 100)
+      for (const auto &e : base)
+        pr.data().push_back(e);
+
+    dataframe copy(pr.data());
+
+    auto [seq, par] = make_evaluators(pr.data(), copy);
+    par.data_parallel(true);
+
+    for (unsigned k(0); k < 100; ++k)
+    {
+      const i_mep ind(pr);
+      CHECK(par(ind)[0] == doctest::Approx(seq(ind)[0]));
+    }
+
+    CHECK(std::equal(pr.data().begin(), pr.data().end(), copy.begin(),
+                     [](const auto &e1, const auto &e2)
+                     {
+                       return e1.difficulty == e2.difficulty;
+                     }));
+  });
+
+  test("iris.csv", [](dataframe &d1, dataframe &d2)
+       {
+         return std::pair(dyn_slot_evaluator<i_mep>(d1),
+                          dyn_slot_evaluator<i_mep>(d2));
+       });
+  test("iris.csv", [](dataframe &d1, dataframe &d2)
+       {
+         return std::pair(gaussian_evaluator<i_mep>(d1),
+                          gaussian_evaluator<i_mep>(d2));
+       });
+  test("ionosphere.csv", [](dataframe &d1, dataframe &d2)
+       {
+         return std::pair(binary_evaluator<i_mep>(d1),
+                          binary_evaluator<i_mep>(d2));
+       });
+}
+
+}  // TEST_SUITE("BATCH INTERPRETER")
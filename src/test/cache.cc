@@ -11,12 +11,15 @@
  */
 
 #include <cstdlib>
+#include <numeric>
 #include <sstream>
+#include <thread>
 
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "third_party/doctest/doctest.h"
 
 #include "kernel/cache.h"
+#include "kernel/lockfree_cache.h"
 #include "kernel/gp/mep/i_mep.h"
 #include "kernel/gp/mep/interpreter.h"
 #include "kernel/gp/src/primitive/factory.h"
@@ -174,6 +177,165 @@ TEST_CASE_FIXTURE(fixture2, "Serialization")
     }
 }
 
+TEST_CASE("Associativity and statistics")
+{
+  using namespace vita;
+
+  cache cache(8);
+  const auto buckets((1u << 8) / cache::k_ways);
+
+  // Signatures sharing the same bucket (same low bits of `data[0]`).
+  const auto sig([&](unsigned i) { return hash_t(1 + i * buckets, i + 1); });
+
+  for (unsigned i(0); i < cache::k_ways; ++i)
+    cache.insert(sig(i), fitness_t{static_cast<double>(i)});
+
+  // Up to `k_ways` colliding signatures coexist.
+  for (unsigned i(0); i < cache::k_ways; ++i)
+    CHECK(cache.find(sig(i)) == fitness_t{static_cast<double>(i)});
+
+  auto s(cache.stats());
+  CHECK(s.hits == cache::k_ways);
+  CHECK(s.misses == 0);
+  CHECK(s.evictions == 0);
+  CHECK(s.collisions == cache::k_ways - 1);
+  CHECK(s.hit_rate() == doctest::Approx(1.0));
+
+  // Updating an existing entry isn't a collision.
+  cache.insert(sig(0), fitness_t{10.0});
+  CHECK(cache.find(sig(0)) == fitness_t{10.0});
+  CHECK(cache.stats().collisions == cache::k_ways - 1);
+
+  // A full bucket evicts its oldest entry.
+  cache.insert(sig(cache::k_ways), fitness_t{-1.0});
+  CHECK(cache.find(sig(cache::k_ways)) == fitness_t{-1.0});
+  CHECK(!cache.find(sig(1)).size());
+  CHECK(cache.find(sig(0)) == fitness_t{10.0});
+
+  s = cache.stats();
+  CHECK(s.evictions == 1);
+  CHECK(s.misses == 1);
+  CHECK(cache.is_valid());
+
+  // Clearing the content keeps the statistics.
+  cache.clear();
+  CHECK(!cache.find(sig(0)).size());
+  CHECK(cache.stats().misses == 2);
+  CHECK(cache.stats().hits == s.hits);
+
+  cache.insert(sig(0), fitness_t{1.0});
+  CHECK(cache.stats().evictions == 1);
+
+  cache.clear(sig(0));
+  CHECK(!cache.find(sig(0)).size());
+}
+
+TEST_CASE_FIXTURE(fixture2, "Lock-free cache")
+{
+  using namespace vita;
+
+  lockfree_cache cache(14);
+  prob.env.mep.code_length = 64;
+
+  const unsigned n(1000);
+  std::vector<i_mep> vi;
+  std::vector<fitness_t> vf;
+
+  for (unsigned i(0); i < n; ++i)
+  {
+    const i_mep i1(prob);
+    const auto val(run(i1));
+    const auto v(has_value(val) ? std::get<D_DOUBLE>(val) : 0.0);
+    const fitness_t f{v, -v};
+
+    cache.insert(i1.signature(), f);
+    CHECK(cache.find(i1.signature()) == f);
+
+    vi.push_back(i1);
+    vf.push_back(f);
+  }
+
+  CHECK(cache.is_valid());
+
+  // Fitnesses too big aren't stored.
+  const hash_t big(123, 456);
+  cache.insert(big, fitness_t(with_size(lockfree_cache::k_fitness_size + 1)));
+  CHECK(!cache.find(big).size());
+
+  // Same serialization format of `cache`.
+  std::stringstream ss;
+  CHECK(cache.save(ss));
+
+  vita::cache cache2(14);
+  CHECK(cache2.load(ss));
+
+  for (unsigned i(0); i < n; ++i)
+  {
+    const fitness_t f(cache.find(vi[i].signature()));
+    if (f.size())
+    {
+      CHECK(f == vf[i]);
+      CHECK(cache2.find(vi[i].signature()) == f);
+    }
+  }
+
+  cache.clear(vi.back().signature());
+  CHECK(!cache.find(vi.back().signature()).size());
+
+  cache.clear();
+  for (const auto &i : vi)
+    CHECK(!cache.find(i.signature()).size());
+}
+
+TEST_CASE("Lock-free cache concurrency")
+{
+  using namespace vita;
+
+  lockfree_cache cache(10);
+
+  // The fitness of a signature is a function of the signature: a torn read
+  // would show an inconsistent pair.
+  const auto sig([](std::uint64_t k) { return hash_t(k, ~k); });
+  const auto fit([](std::uint64_t k)
+                 {
+                   return fitness_t{static_cast<double>(k),
+                                    -static_cast<double>(k)};
+                 });
+
+  const unsigned n_threads(4), n(20000);
+  std::vector<unsigned> errors(n_threads);
+
+  std::vector<std::thread> workers;
+  for (unsigned t(0); t < n_threads; ++t)
+    workers.emplace_back([&, t]
+    {
+      for (std::uint64_t i(0); i < n; ++i)
+      {
+        // Every key is looked up twice in a row: hits don't depend on the
+        // scheduling of the threads.
+        const std::uint64_t k(1 + (i / 2 * 7 + t) % 3000);
+
+        if (const fitness_t f(cache.find(sig(k))); f.size())
+        {
+          if (f != fit(k))
+            ++errors[t];
+        }
+        else
+          cache.insert(sig(k), fit(k));
+      }
+    });
+
+  for (auto &w : workers)
+    w.join();
+
+  CHECK(std::accumulate(errors.begin(), errors.end(), 0u) == 0);
+  CHECK(cache.is_valid());
+
+  const auto s(cache.stats());
+  CHECK(s.hits + s.misses == n_threads * n);
+  CHECK(s.hits > 0);
+}
+
 TEST_CASE("Type hash_t")
 {
   const vita::hash_t empty;
@@ -10,8 +10,11 @@
  *  You can obtain one at http://mozilla.org/MPL/2.0/
  */
 
+#include <filesystem>
+#include <fstream>
 #include <sstream>
 
+#include "kernel/exceptions.h"
 #include "kernel/random.h"
 #include "kernel/gp/src/dataframe.h"
 
@@ -380,4 +383,191 @@ TEST_CASE("load_xrff_classification")
   CHECK(d.class_name(2) == "Iris-virginica");
 }
 
+TEST_CASE("columnar")
+{
+  using namespace vita;
+
+  dataframe d;
+
+  const std::vector<std::string> colours = {"red", "green", "red", "blue"};
+  for (unsigned i(0); i < colours.size(); ++i)
+  {
+    dataframe::example e;
+    e.input = {static_cast<D_DOUBLE>(i) / 2.0, static_cast<D_INT>(i),
+               colours[i]};
+    e.output = static_cast<D_DOUBLE>(i * i);
+    e.difficulty = i;
+    e.age = 2 * i;
+
+    d.push_back(e);
+  }
+
+  const dataframe::columnar c(d);
+  CHECK(c.is_valid());
+  CHECK(c.size() == d.size());
+  CHECK(!c.empty());
+  CHECK(c.variables() == d.variables());
+
+  CHECK(c.input(0).domain == d_double);
+  CHECK(c.input(1).domain == d_int);
+  CHECK(c.input(2).domain == d_string);
+  CHECK(c.output().domain == d_double);
+
+  // Strings are stored once.
+  CHECK(c.input(2).dictionary.size() == 3);
+
+  std::size_t i(0);
+  for (const auto &e : d)
+  {
+    CHECK(c.row(i) == e.input);
+    CHECK(c.output()[i] == e.output);
+    CHECK(c.difficulty[i] == e.difficulty);
+    CHECK(c.age[i] == e.age);
+    ++i;
+  }
+
+  CHECK(dataframe::columnar(dataframe()).empty());
+
+  dataframe::example mixed;
+  mixed.input = {1, 1, "red"};
+  mixed.output = 0.0;
+  d.push_back(mixed);
+  CHECK_THROWS_AS(dataframe::columnar{d}, exception::data_format);
+}
+
+TEST_CASE("binary format")
+{
+  using namespace vita;
+
+  const auto check_round_trip([](const dataframe &d1)
+  {
+    const auto fn(std::filesystem::temp_directory_path()
+                  / ("vita_dataframe_"
+                     + std::to_string(random::between(0, 1000000)) + ".vdf"));
+
+    d1.write_binary(fn);
+
+    dataframe d2;
+    CHECK(d2.read(fn) == d1.size());
+    CHECK(d2.is_valid());
+
+    CHECK(d2.classes() == d1.classes());
+    CHECK(d2.variables() == d1.variables());
+    for (class_t c(0); c < d1.classes(); ++c)
+      CHECK(d2.class_name(c) == d1.class_name(c));
+
+    REQUIRE(d2.columns.size() == d1.columns.size());
+    for (std::size_t i(0); i < d1.columns.size(); ++i)
+    {
+      CHECK(d2.columns[i].name == d1.columns[i].name);
+      CHECK(d2.columns[i].domain == d1.columns[i].domain);
+      CHECK(d2.columns[i].states == d1.columns[i].states);
+    }
+
+    CHECK(std::equal(d1.begin(), d1.end(), d2.begin(), d2.end(),
+                     [](const auto &e1, const auto &e2)
+                     {
+                       return e1.input == e2.input && e1.output == e2.output;
+                     }));
+
+    std::filesystem::remove(fn);
+  });
+
+  dataframe iris;
+  iris.read("./test_resources/iris.csv");
+  check_round_trip(iris);
+
+  dataframe mixed;
+  const std::vector<std::string> colours = {"red", "green", "red", "blue"};
+  for (unsigned i(0); i < colours.size(); ++i)
+  {
+    dataframe::example e;
+    e.input = {static_cast<D_DOUBLE>(i) / 3.0, static_cast<D_INT>(-i),
+               colours[i]};
+    e.output = static_cast<D_DOUBLE>(i * i);
+    mixed.push_back(e);
+  }
+  check_round_trip(mixed);
+
+  const auto fn(std::filesystem::temp_directory_path() / "vita_wrong.vdf");
+  std::ofstream(fn) << "1,2,3";
+  dataframe d;
+  CHECK_THROWS_AS(d.read(fn), exception::data_format);
+  std::filesystem::remove(fn);
+}
+
+TEST_CASE("load_csv multithread")
+{
+  using namespace vita;
+
+  const auto same([](const dataframe &d1, const dataframe &d2)
+  {
+    CHECK(d1.size() == d2.size());
+    CHECK(d1.classes() == d2.classes());
+    for (class_t c(0); c < d1.classes(); ++c)
+      CHECK(d1.class_name(c) == d2.class_name(c));
+
+    REQUIRE(d1.columns.size() == d2.columns.size());
+    for (std::size_t i(0); i < d1.columns.size(); ++i)
+    {
+      CHECK(d1.columns[i].name == d2.columns[i].name);
+      CHECK(d1.columns[i].domain == d2.columns[i].domain);
+      CHECK(d1.columns[i].states == d2.columns[i].states);
+    }
+
+    CHECK(std::equal(d1.begin(), d1.end(), d2.begin(), d2.end(),
+                     [](const auto &e1, const auto &e2)
+                     {
+                       return e1.input == e2.input && e1.output == e2.output;
+                     }));
+  });
+
+  const auto check([&same](const std::filesystem::path &fn,
+                           dataframe::params p)
+  {
+    std::ifstream in(fn);
+    dataframe reference;
+    reference.read_csv(in, p);
+
+    for (unsigned threads : {1u, 2u, 5u})
+    {
+      p.threads = threads;
+
+      dataframe d;
+      CHECK(d.read(fn, p) == reference.size());
+      CHECK(d.is_valid());
+      same(d, reference);
+    }
+  });
+
+  check("./test_resources/iris.csv", {});
+  check("./test_resources/ionosphere.csv", {});
+  check("./test_resources/mep.csv", {});
+
+  // Header, textual features, quotes, empty and malformed lines, numbers in
+  // uncommon formats.
+  const auto fn(std::filesystem::temp_directory_path() / "vita_mt.csv");
+  {
+    std::ofstream out(fn);
+    out << "colour,size,weight,kind\n";
+    for (unsigned i(0); i < 200; ++i)
+    {
+      out << (i % 3 ? "red" : "\"dark, blue\"") << ',' << i % 7 << ','
+          << (i % 5 ? std::to_string(i / 3.0) : "+1e2") << ','
+          << (i % 4 ? "alpha" : "beta") << "\n";
+
+      if (i % 50 == 0)
+        out << "\n  \n";
+      if (i == 120)
+        out << "green,1,2,3,4\n";
+    }
+  }
+
+  dataframe::params p;
+  p.dialect.delimiter = ',';
+  check(fn, p.header().output(3));
+  check(fn, p.header().no_output());
+  std::filesystem::remove(fn);
+}
+
 }  // TEST_SUITE("DATAFRAME")
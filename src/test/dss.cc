@@ -0,0 +1,76 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2024 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#include <sstream>
+#include <utility>
+
+#include "kernel/gp/src/primitive/real.h"
+#include "kernel/gp/src/search.h"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "third_party/doctest/doctest.h"
+
+TEST_SUITE("DSS")
+{
+
+TEST_CASE("Concurrent workers")
+{
+  using namespace vita;
+
+  log::reporting_level = log::lERROR;
+
+  // The target function is `x + sin(x)`.
+  std::ostringstream data;
+  for (int i(-20); i <= 20; ++i)
+  {
+    const double x(i / 2.0);
+    data << x + std::sin(x) << ',' << x << '\n';
+  }
+
+  // DSS changes the difficulty of the training examples: workers would race
+  // on them, so evolution falls back to one worker and is reproducible.
+  const auto run([&data]
+  {
+    std::istringstream training(data.str());
+    src_problem prob(training);
+    REQUIRE(!!prob);
+
+    prob.insert<real::sin>();
+    prob.insert<real::add>();
+    prob.insert<real::sub>();
+    prob.insert<real::mul>();
+
+    prob.env.individuals = 50;
+    prob.env.generations = 20;
+    prob.env.dss = 5;
+    prob.env.threads = 4;
+
+    random::seed(1);
+
+    src_search s(prob);
+    s.validation_strategy(validator_id::dss);
+    const auto result(s.run(2));
+
+    // Symbols belong to `prob`: the solution is compared in textual form.
+    std::ostringstream solution;
+    solution << result.best.solution;
+    return std::make_pair(solution.str(), result.best.score.fitness);
+  });
+
+  const auto s1(run());
+  const auto s2(run());
+
+  CHECK(s1.first == s2.first);
+  CHECK(s1.second == s2.second);
+}
+
+}  // TEST_SUITE("DSS")
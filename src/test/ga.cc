@@ -10,8 +10,10 @@
  *  You can obtain one at http://mozilla.org/MPL/2.0/
  */
 
+#include <atomic>
 #include <cstdlib>
 #include <sstream>
+#include <thread>
 
 #include "kernel/ga/evaluator.h"
 #include "kernel/ga/i_ga.h"
@@ -64,4 +66,232 @@ TEST_CASE_FIXTURE(fixture6, "Evolution")
   CHECK(s2.best.solution[3] > 9950);
 }
 
+TEST_CASE_FIXTURE(fixture6, "Concurrent evolution")
+{
+  prob.env.individuals = 100;
+  prob.env.threads = 4;
+
+  vita::log::reporting_level = vita::log::lERROR;
+
+  auto eva(vita::make_ga_evaluator<vita::i_ga>(
+             [](const vita::i_ga &v)
+             {
+               return std::accumulate(v.begin(), v.end(), 0.0,
+                                      [](double sum, auto g)
+                                      {
+                                        return sum + g;
+                                      });
+             }));
+
+  vita::evolution<vita::i_ga, vita::std_es> evo(prob, eva);
+  CHECK(evo.is_valid());
+
+  const auto s(evo.run(1));
+
+  CHECK(s.crossovers + s.mutations > 0);
+  CHECK(s.best.solution[0] >    8);
+  CHECK(s.best.solution[1] >   95);
+  CHECK(s.best.solution[2] >  950);
+  CHECK(s.best.solution[3] > 9950);
+
+  // Given the seed and the number of threads, evolution is reproducible.
+  vita::random::seed(1);
+  vita::evolution<vita::i_ga, vita::std_es> evo1(prob, eva);
+  const auto s1(evo1.run(1));
+
+  vita::random::seed(1);
+  vita::evolution<vita::i_ga, vita::std_es> evo2(prob, eva);
+  const auto s2(evo2.run(1));
+
+  CHECK(s1.best.solution == s2.best.solution);
+  CHECK(s1.crossovers == s2.crossovers);
+  CHECK(s1.mutations == s2.mutations);
+
+  // Without a cache, every offspring is evaluated just once.
+  std::atomic<unsigned> evaluations(0);
+  auto counting_eva(vita::make_ga_evaluator<vita::i_ga>(
+                      [&evaluations](const vita::i_ga &v)
+                      {
+                        ++evaluations;
+                        return std::accumulate(v.begin(), v.end(), 0.0);
+                      }));
+
+  prob.env.brood_recombination = 1;
+  vita::evolution<vita::i_ga, vita::std_es> evo3(prob, counting_eva);
+  const auto s3(evo3.run(1));
+  CHECK(evaluations <= 1 + prob.env.individuals * (s3.gen + 1));
+
+  // Strategies not supporting concurrent workers fall back to one thread.
+  vita::evolution<vita::i_ga, vita::alps_es> evo_alps(prob, eva);
+  const auto s_alps(evo_alps.run(1));
+  CHECK(s_alps.best.solution[3] > 9950);
+}
+
+TEST_CASE_FIXTURE(fixture6, "Island evolution")
+{
+  prob.env.individuals = 50;
+  prob.env.layers = 4;
+  prob.env.threads = 2;
+
+  vita::log::reporting_level = vita::log::lERROR;
+
+  auto eva(vita::make_ga_evaluator<vita::i_ga>(
+             [](const vita::i_ga &v)
+             {
+               return std::accumulate(v.begin(), v.end(), 0.0,
+                                      [](double sum, auto g)
+                                      {
+                                        return sum + g;
+                                      });
+             }));
+
+  for (auto t : {vita::island::topology::ring,
+                 vita::island::topology::random,
+                 vita::island::topology::complete})
+  {
+    prob.env.island.topology = t;
+
+    vita::evolution<vita::i_ga, vita::island_es> evo(prob, eva);
+    CHECK(evo.is_valid());
+
+    const auto s(evo.run(1));
+
+    CHECK(s.best.solution[0] >    8);
+    CHECK(s.best.solution[1] >   95);
+    CHECK(s.best.solution[2] >  950);
+    CHECK(s.best.solution[3] > 9950);
+  }
+
+  // Given the seed and the number of threads, evolution is reproducible.
+  vita::random::seed(1);
+  vita::evolution<vita::i_ga, vita::island_es> evo1(prob, eva);
+  const auto s1(evo1.run(1));
+
+  vita::random::seed(1);
+  vita::evolution<vita::i_ga, vita::island_es> evo2(prob, eva);
+  const auto s2(evo2.run(1));
+
+  CHECK(s1.best.solution == s2.best.solution);
+  CHECK(s1.crossovers == s2.crossovers);
+  CHECK(s1.mutations == s2.mutations);
+
+  // A single worker runs on the calling thread.
+  prob.env.threads = 1;
+
+  const auto caller(std::this_thread::get_id());
+  std::atomic<bool> other_thread(false);
+  auto eva1(vita::make_ga_evaluator<vita::i_ga>(
+              [&](const vita::i_ga &v)
+              {
+                if (std::this_thread::get_id() != caller)
+                  other_thread = true;
+
+                return std::accumulate(v.begin(), v.end(), 0.0,
+                                       [](double sum, auto g)
+                                       {
+                                         return sum + g;
+                                       });
+              }));
+
+  vita::evolution<vita::i_ga, vita::island_es> evo3(prob, eva1);
+  const auto s3(evo3.run(1));
+
+  CHECK(!other_thread);
+  CHECK(s3.best.solution[3] > 9950);
+}
+
+TEST_CASE_FIXTURE(fixture6, "Island migration")
+{
+  prob.env.individuals = 10;
+  prob.env.layers = 3;
+  prob.env.island.migrants = 2;
+  prob.env.island.migration_interval = 5;
+  prob.env.island.topology = vita::island::topology::ring;
+
+  auto eva(vita::make_ga_evaluator<vita::i_ga>(
+             [](const vita::i_ga &v)
+             {
+               return std::accumulate(v.begin(), v.end(), 0.0,
+                                      [](double sum, auto g)
+                                      {
+                                        return sum + g;
+                                      });
+             }));
+
+  vita::population<vita::i_ga> pop(prob);
+  vita::summary<vita::i_ga> sum;
+  vita::island_es<vita::i_ga> es(pop, eva, &sum);
+
+  const auto best_of([&](unsigned l)
+  {
+    vita::i_ga ret(pop[{l, 0}]);
+    for (unsigned i(1); i < pop.individuals(l); ++i)
+      if (eva(pop[{l, i}]) > eva(ret))
+        ret = pop[{l, i}];
+    return ret;
+  });
+
+  std::vector<vita::i_ga> best;
+  for (unsigned l(0); l < pop.layers(); ++l)
+    best.push_back(best_of(l));
+
+  // No migration outside the migration interval.
+  const auto before(pop);
+  sum.gen = 3;
+  es.after_generation();
+  for (unsigned l(0); l < pop.layers(); ++l)
+    for (unsigned i(0); i < pop.individuals(l); ++i)
+      CHECK(pop[{l, i}] == before[{l, i}]);
+
+  // Every island receives the best individuals of the previous one.
+  sum.gen = 5;
+  es.after_generation();
+  for (unsigned l(0); l < pop.layers(); ++l)
+  {
+    const auto dest((l + 1) % pop.layers());
+
+    bool found(false);
+    for (unsigned i(0); i < pop.individuals(dest); ++i)
+      found = found || pop[{dest, i}] == best[l];
+
+    CHECK(found);
+    CHECK(eva(best_of(dest)) >= eva(best[l]));
+  }
+}
+
+TEST_CASE_FIXTURE(fixture6, "Concurrent runs")
+{
+  prob.env.individuals = 100;
+  prob.env.generations = 50;
+  prob.env.concurrent_runs = 4;
+
+  vita::log::reporting_level = vita::log::lERROR;
+
+  auto f = [](const vita::i_ga &v)
+           {
+             return std::accumulate(v.begin(), v.end(), 0.0,
+                                    [](double sum, auto g)
+                                    {
+                                      return sum + g;
+                                    });
+           };
+
+  vita::random::seed(1);
+  vita::ga_search<decltype(f)> s1(prob, f);
+  const auto r1(s1.run(8));
+
+  CHECK(r1.best.solution[0] >    8);
+  CHECK(r1.best.solution[1] >   95);
+  CHECK(r1.best.solution[2] >  950);
+  CHECK(r1.best.solution[3] > 9950);
+
+  // Given the seed, results don't depend on the scheduling of the runs.
+  vita::random::seed(1);
+  vita::ga_search<decltype(f)> s2(prob, f);
+  const auto r2(s2.run(8));
+
+  CHECK(r1.best.solution == r2.best.solution);
+  CHECK(r1.gen == r2.gen);
+}
+
 }  // TEST_SUITE("GA")
@@ -11,6 +11,8 @@
  */
 
 #include <cstdlib>
+#include <cstring>
+#include <set>
 #include <sstream>
 
 #include "kernel/gp/mep/i_mep.h"
@@ -315,4 +317,165 @@ TEST_CASE_FIXTURE(fixture3, "Random locus")
   }
 }
 
+TEST_CASE_FIXTURE(fixture3, "Signature")
+{
+  using namespace vita;
+
+  // Same expression, different layouts.
+  const i_mep i1({
+                   {{f_add, {1, 2}}},  // [0] FADD [1], [2]
+                   {{    x,   null}},  // [1] X
+                   {{    y,   null}}   // [2] Y
+                 });
+  const i_mep i2({
+                   {{f_add, {2, 1}}},  // [0] FADD [2], [1]
+                   {{    y,   null}},  // [1] Y
+                   {{    x,   null}}   // [2] X
+                 });
+  CHECK(i1.signature() == i2.signature());
+
+  const i_mep i3({
+                   {{f_add, {2, 1}}},  // [0] FADD [2], [1]
+                   {{    x,   null}},  // [1] X
+                   {{    y,   null}}   // [2] Y
+                 });
+  CHECK(i1.signature() != i3.signature());
+
+  // Every argument contributes to the signature (`real::ifb` has five).
+  auto *f_ifb(prob.sset.insert<real::ifb>());
+
+  const i_mep i5({
+                   {{f_ifb, {1, 1, 1, 1, 1}}},  // [0] FIFB [1], ..., [1]
+                   {{    x,           null}},  // [1] X
+                   {{    y,           null}}   // [2] Y
+                 });
+  const i_mep i6({
+                   {{f_ifb, {1, 1, 1, 1, 2}}},  // [0] FIFB [1], ..., [2]
+                   {{    x,           null}},  // [1] X
+                   {{    y,           null}}   // [2] Y
+                 });
+  CHECK(i5.signature() != i6.signature());
+
+  // Heavy reuse of subexpressions: `[i] FADD [i+1] [i+1]`. The equivalent
+  // tree has `2^length` nodes but every locus is hashed once.
+  const index_t length(500);
+  std::vector<gene> chain;
+  for (index_t i(0); i + 1 < length; ++i)
+    chain.emplace_back(std::make_pair(f_add,
+                                     std::vector<index_t>{i + 1, i + 1}));
+  chain.emplace_back(std::make_pair(x, null));
+
+  const i_mep i4(chain);
+  CHECK(!i4.signature().empty());
+
+  chain.back() = gene(std::make_pair(y, null));
+  CHECK(i4.signature() != i_mep(chain).signature());
+}
+
+TEST_CASE_FIXTURE(fixture3, "Incremental signature")
+{
+  using namespace vita;
+
+  prob.env.p_mutation = 0.1;
+
+  for (unsigned k(0); k < 1000; ++k)
+  {
+    i_mep i1(prob), i2(prob);
+    CHECK(!i1.signature().empty());
+    CHECK(!i2.signature().empty());
+
+    // `is_valid` checks every cached hash against a full recomputation.
+    i1.mutation(prob.env.p_mutation, prob);
+    CHECK(!i1.signature().empty());
+    CHECK(i1.is_valid());
+
+    const auto off(crossover(i1, i2));
+    CHECK(!off.signature().empty());
+    CHECK(off.is_valid());
+
+    const auto l(random_locus(off));
+    const auto i3(off.replace(l,
+                              gene(prob.sset.roulette_terminal(l.category))));
+    CHECK(!i3.signature().empty());
+    CHECK(i3.is_valid());
+
+    const auto i4(i3.destroy_block(random::sup(i3.size()), prob.sset));
+    CHECK(!i4.signature().empty());
+    CHECK(i4.is_valid());
+  }
+}
+
+TEST_CASE_FIXTURE(fixture3, "Active loci")
+{
+  using namespace vita;
+
+  // Reference implementation: explores the active code via a set of loci.
+  const auto reference([](const i_mep &prg)
+  {
+    std::set<locus> exons({prg.best()});
+    for (auto it(exons.begin()); it != exons.end(); ++it)
+    {
+      const auto args(prg[*it].arguments());
+      exons.insert(args.begin(), args.end());
+    }
+
+    return std::vector<locus>(exons.begin(), exons.end());
+  });
+
+  prob.env.p_mutation = 0.1;
+
+  for (unsigned k(0); k < 500; ++k)
+  {
+    i_mep i1(prob);
+    const i_mep i2(prob);
+    CHECK(i1.exons() == reference(i1));
+
+    std::vector<locus> visited;
+    for (auto it(i1.begin()); it != i1.end(); ++it)
+      visited.push_back(it.locus());
+    CHECK(visited == i1.exons());
+    CHECK(i1.active_symbols() == visited.size());
+
+    i1.mutation(prob.env.p_mutation, prob);
+    CHECK(i1.exons() == reference(i1));
+
+    const auto off(crossover(i1, i2));
+    CHECK(off.exons() == reference(off));
+
+    const auto l(random_locus(off));
+    CHECK(std::binary_search(off.exons().begin(), off.exons().end(), l));
+
+    const auto blk(off.get_block(l));
+    CHECK(blk.exons() == reference(blk));
+
+    const auto i3(off.destroy_block(random::sup(off.size()), prob.sset));
+    CHECK(i3.exons() == reference(i3));
+
+    const auto i4(off.cse());
+    CHECK(i4.exons() == reference(i4));
+    CHECK(i4.is_valid());
+  }
+}
+
+TEST_CASE_FIXTURE(fixture3, "Compact genes")
+{
+  using namespace vita;
+
+  static_assert(std::is_trivially_copyable_v<gene>);
+  static_assert(sizeof(gene) <= sizeof(const symbol *) + 16);
+
+  const gene g1(std::make_pair(f_ife, std::vector<index_t>{1, 2, 3, 4}));
+  CHECK(g1.args.size() == 4);
+
+  gene g2;
+  std::memcpy(&g2, &g1, sizeof(gene));
+  CHECK(g2 == g1);
+  CHECK(g2.arguments() == g1.arguments());
+
+  const gene t1(*terminal::cast(c0));
+  const gene t2(t1);
+  CHECK(t2 == t1);
+  CHECK(t2 != g1);
+}
+
 }  // TEST_SUITE("I_MEP")
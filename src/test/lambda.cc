@@ -11,6 +11,7 @@
  */
 
 #include <cstdlib>
+#include <filesystem>
 
 #include "kernel/gp/mep/i_mep.h"
 #include "kernel/gp/src/lambda_f.h"
@@ -214,6 +215,80 @@ TEST_CASE_FIXTURE(fixture, "reg_lambda")
   }
 }
 
+TEST_CASE_FIXTURE(fixture, "Native code")
+{
+  using namespace vita;
+
+  const auto dir(std::filesystem::temp_directory_path() / "vita_native_test");
+  std::filesystem::remove_all(dir);
+
+  CHECK(pr.data().read("./test_resources/mep.csv") == MEP_COUNT);
+  pr.setup_symbols();
+
+  for (unsigned i(0); i < 20; ++i)
+  {
+    const i_mep ind(pr);
+    const reg_lambda_f<i_mep> interpreted(ind);
+    reg_lambda_f<i_mep> lambda(ind);
+
+    const bool native(lambda.compile_native(dir));
+    if (native_code::source(ind).empty())
+      CHECK(!native);
+
+    // A copy shares the machine code.
+    const auto copy(lambda);
+
+    for (const auto &e : pr.data())
+    {
+      const auto out(interpreted(e));
+
+      for (const auto &out_n : {lambda(e), copy(e)})
+        if (has_value(out))
+          CHECK(std::get<D_DOUBLE>(out)
+                == doctest::Approx(std::get<D_DOUBLE>(out_n)));
+        else
+          CHECK(!has_value(out_n));
+    }
+
+    if (native)
+    {
+      // The shared object is cached on disk.
+      const auto files(std::distance(std::filesystem::directory_iterator(dir),
+                                     std::filesystem::directory_iterator()));
+      CHECK(reg_lambda_f<i_mep>(ind).compile_native(dir));
+      CHECK(std::distance(std::filesystem::directory_iterator(dir),
+                          std::filesystem::directory_iterator()) == files);
+    }
+  }
+
+  // Classification.
+  src_problem iris;
+  iris.env.init();
+  CHECK(iris.data().read("./test_resources/iris.csv") == IRIS_COUNT);
+  iris.setup_symbols();
+
+  for (unsigned i(0); i < 3; ++i)
+  {
+    const i_mep ind(iris);
+    const gaussian_lambda_f<i_mep> interpreted(ind, iris.data());
+    auto lambda(interpreted);
+    lambda.compile_native(dir);
+
+    const team<i_mep> t{{ind, i_mep(iris)}};
+    const dyn_slot_lambda_f<team<i_mep>> t_interpreted(t, iris.data(), 10);
+    auto t_lambda(t_interpreted);
+    t_lambda.compile_native(dir);
+
+    for (const auto &e : iris.data())
+    {
+      CHECK(lambda.tag(e).label == interpreted.tag(e).label);
+      CHECK(t_lambda.tag(e).label == t_interpreted.tag(e).label);
+    }
+  }
+
+  std::filesystem::remove_all(dir);
+}
+
 TEST_CASE_FIXTURE(fixture, "reg_lambda serialization")
 {
   using namespace vita;
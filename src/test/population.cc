@@ -125,4 +125,72 @@ TEST_CASE_FIXTURE(fixture1, "Pickup")
   }
 }
 
+TEST_CASE_FIXTURE(fixture1, "Stored fitness")
+{
+  using namespace vita;
+
+  prob.env.individuals = 30;
+  prob.env.layers = 1;
+
+  population<i_mep> pop(prob);
+  pop.add_layer();
+
+  unsigned calls(0);
+  const auto eva([&calls](const i_mep &prg)
+                 {
+                   ++calls;
+                   return fitness_t{static_cast<double>(prg.active_symbols())};
+                 });
+
+  for (unsigned l(0); l < pop.layers(); ++l)
+    for (unsigned i(0); i < pop.individuals(l); ++i)
+      CHECK(!pop.stored_fitness({l, i}));
+
+  pop.evaluate(eva);
+  CHECK(calls == pop.individuals());
+  CHECK(pop.is_valid());
+
+  // Known fitnesses don't require the evaluator.
+  calls = 0;
+  pop.evaluate(eva);
+  for (unsigned l(0); l < pop.layers(); ++l)
+    for (unsigned i(0); i < pop.individuals(l); ++i)
+    {
+      const fitness_t expected{
+        static_cast<double>(pop[{l, i}].active_symbols())};
+
+      REQUIRE(pop.stored_fitness({l, i}));
+      CHECK(*pop.stored_fitness({l, i}) == expected);
+      CHECK(pop.fitness({l, i}, eva) == expected);
+    }
+  CHECK(calls == 0);
+
+  // Replacing an individual makes its stored fitness outdated...
+  const population<i_mep>::coord c{1, 0};
+  i_mep other(prob);
+  while (other.signature() == pop[c].signature())
+    other = i_mep(prob);
+
+  pop[c] = other;
+  CHECK(!pop.stored_fitness(c));
+  CHECK(pop.fitness(c, eva) == fitness_t{
+          static_cast<double>(other.active_symbols())});
+  CHECK(calls == 1);
+
+  // ... until a new one is stored.
+  pop.store_fitness(c, fitness_t{-1.0});
+  CHECK(pop.fitness(c, eva) == fitness_t{-1.0});
+  CHECK(calls == 1);
+
+  // New layers have no stored fitness.
+  pop.add_layer();
+  CHECK(!pop.stored_fitness({0, 0}));
+  CHECK(pop.stored_fitness({2, 0}));
+
+  pop.clear_fitness();
+  for (unsigned l(0); l < pop.layers(); ++l)
+    for (unsigned i(0); i < pop.individuals(l); ++i)
+      CHECK(!pop.stored_fitness({l, i}));
+}
+
 }  // TEST_SUITE("POPULATION")
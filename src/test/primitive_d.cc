@@ -15,6 +15,7 @@
 
 #include "kernel/random.h"
 #include "kernel/gp/mep/i_mep.h"
+#include "kernel/gp/src/primitive/real.h"
 
 #include "test/fixture3.h"
 
@@ -595,4 +596,103 @@ TEST_CASE_FIXTURE(fixture3, "f_sigmoid")
   }
 }
 
+TEST_CASE("Vector kernels")
+{
+  using namespace vita;
+
+  // Arguments for the scalar version of a function.
+  class params : public symbol_params
+  {
+  public:
+    explicit params(std::vector<value_t> a) : args_(std::move(a)) {}
+
+    value_t fetch_arg(unsigned i) final { return args_[i]; }
+    value_t fetch_opaque_arg(unsigned i) final { return args_[i]; }
+    terminal_param_t fetch_param() const final { return 0.0; }
+
+  private:
+    std::vector<value_t> args_;
+  };
+
+  std::vector<std::unique_ptr<function>> functions;
+  functions.push_back(std::make_unique<real::abs>());
+  functions.push_back(std::make_unique<real::add>());
+  functions.push_back(std::make_unique<real::aq>());
+  functions.push_back(std::make_unique<real::cos>());
+  functions.push_back(std::make_unique<real::div>());
+  functions.push_back(std::make_unique<real::idiv>());
+  functions.push_back(std::make_unique<real::ifb>());
+  functions.push_back(std::make_unique<real::ife>());
+  functions.push_back(std::make_unique<real::ifl>());
+  functions.push_back(std::make_unique<real::ifz>());
+  functions.push_back(std::make_unique<real::ln>());
+  functions.push_back(std::make_unique<real::max>());
+  functions.push_back(std::make_unique<real::mod>());
+  functions.push_back(std::make_unique<real::mul>());
+  functions.push_back(std::make_unique<real::sigmoid>());
+  functions.push_back(std::make_unique<real::sin>());
+  functions.push_back(std::make_unique<real::sqrt>());
+  functions.push_back(std::make_unique<real::sub>());
+
+  // Special values make equalities, overflows and domain errors frequent.
+  const std::vector<real::base_t> special =
+  {
+    0.0, -0.0, 1.0, -1.0, 2.0, 1e-20, 1e300, -1e300
+  };
+
+  const std::size_t n(1001);  // not a multiple of the vector width
+
+  for (const auto &f : functions)
+  {
+    const auto *kernel(dynamic_cast<const real::vector_kernel *>(f.get()));
+    REQUIRE(kernel);
+
+    const auto arity(f->arity());
+
+    std::vector<std::vector<real::base_t>> val(arity);
+    std::vector<std::vector<real::mask_t>> ok(arity);
+    std::vector<real::const_column> args;
+    for (unsigned a(0); a < arity; ++a)
+    {
+      for (std::size_t i(0); i < n; ++i)
+      {
+        val[a].push_back(random::boolean(0.3)
+                         ? random::element(special)
+                         : random::between(-10.0, 10.0));
+        ok[a].push_back(random::boolean(0.9));
+      }
+
+      args.push_back({val[a].data(), ok[a].data()});
+    }
+
+    std::vector<real::base_t> out_val(n);
+    std::vector<real::mask_t> out_ok(n);
+    kernel->eval_columns(args.data(), {out_val.data(), out_ok.data()}, n);
+
+    for (std::size_t i(0); i < n; ++i)
+    {
+      std::vector<value_t> scalar_args;
+      for (unsigned a(0); a < arity; ++a)
+        scalar_args.push_back(ok[a][i] ? value_t(val[a][i]) : value_t());
+
+      params p(scalar_args);
+      const auto expected(f->eval(p));
+
+      CHECK(static_cast<bool>(out_ok[i]) == has_value(expected));
+      if (out_ok[i] && has_value(expected))
+        CHECK(out_val[i] == real::base(expected));
+
+      // Scalar kernel (NaN is the empty value).
+      std::vector<real::base_t> real_args;
+      for (unsigned a(0); a < arity; ++a)
+        real_args.push_back(ok[a][i] ? val[a][i] : real::empty());
+
+      const auto r(kernel->eval_scalar(real_args.data()));
+      CHECK(std::isnan(r) == !has_value(expected));
+      if (has_value(expected))
+        CHECK(r == real::base(expected));
+    }
+  }
+}
+
 }  // TEST_SUITE("PRIMITIVE_D")
@@ -0,0 +1,88 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2024 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#include <future>
+#include <set>
+
+#include "kernel/random.h"
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "third_party/doctest/doctest.h"
+
+TEST_SUITE("RANDOM")
+{
+
+TEST_CASE("Jump")
+{
+  vigna::xoshiro256ss e1(42), e2(42);
+
+  e1.jump();
+  CHECK(e1 != e2);
+
+  e2.jump();
+  CHECK(e1 == e2);
+
+  e2.long_jump();
+  CHECK(e1 != e2);
+
+  vigna::xoroshiro128p f1(42), f2(42);
+
+  f1.jump();
+  CHECK(f1 != f2);
+
+  f2.jump();
+  CHECK(f1 == f2);
+}
+
+TEST_CASE("Streams")
+{
+  using namespace vita;
+
+  random::seed(42);
+  const auto s1(random::streams(4));
+  const auto s2(random::streams(4));
+
+  random::seed(42);
+  const auto s3(random::streams(4));
+
+  CHECK(s1 == s3);
+
+  for (unsigned i(0); i < s1.size(); ++i)
+    for (unsigned j(0); j < s1.size(); ++j)
+    {
+      CHECK(s1[i] != s2[j]);
+      if (i != j)
+        CHECK(s1[i] != s1[j]);
+    }
+
+  // Workers using the streams produce the same numbers independently of the
+  // scheduling.
+  const auto draw([](const random::engine_t &e)
+  {
+    random::engine = e;
+
+    std::vector<int> ret(100);
+    for (auto &x : ret)
+      x = random::between(0, 1000);
+
+    return ret;
+  });
+
+  std::vector<std::future<std::vector<int>>> workers;
+  for (const auto &e : s1)
+    workers.push_back(std::async(std::launch::async, draw, e));
+
+  for (unsigned i(0); i < s1.size(); ++i)
+    CHECK(workers[i].get() == draw(s3[i]));
+}
+
+}  // TEST_SUITE("RANDOM")
@@ -13,6 +13,7 @@
 #include <cstdlib>
 #include <iostream>
 #include <map>
+#include <stdexcept>
 
 #include "kernel/gp/mep/i_mep.h"
 #include "kernel/gp/src/primitive/factory.h"
@@ -85,6 +86,15 @@ TEST_CASE("Constructor / Insertion")
   CHECK(prob.sset.decode("FADD") == fadd);
   CHECK(prob.sset.decode(fadd->opcode()) == fadd);
 
+  // Too many arguments
+  struct wide_function : vita::function
+  {
+    wide_function() : vita::function("WIDE", vita::gene::k_args + 1) {}
+    vita::value_t eval(vita::symbol_params &) const override { return {}; }
+  };
+  CHECK_THROWS_AS(prob.sset.insert(std::make_unique<wide_function>()),
+                  std::invalid_argument);
+
   // Reset
   prob.sset.clear();
 
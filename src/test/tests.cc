@@ -10,11 +10,13 @@
  *  You can obtain one at http://mozilla.org/MPL/2.0/
  */
 
+#include "test/batch_interpreter.cc"
 #include "test/cache.cc"
 #include "test/category_set.cc"
 #include "test/dataframe.cc"
 #include "test/de.cc"
 #include "test/discretization.cc"
+#include "test/dss.cc"
 #include "test/evolution.cc"
 #include "test/evolution_selection.cc"
 #include "test/facultative.cc"
@@ -30,6 +32,7 @@
 #include "test/population_coord.cc"
 #include "test/primitive_d.cc"
 #include "test/primitive_i.cc"
+#include "test/random.cc"
 #include "test/small_vector.cc"
 #include "test/src_constant.cc"
 #include "test/src_problem.cc"
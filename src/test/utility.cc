@@ -10,8 +10,11 @@
  *  You can obtain one at http://mozilla.org/MPL/2.0/
  */
 
+#include <atomic>
 #include <sstream>
+#include <stdexcept>
 
+#include "utility/thread_pool.h"
 #include "utility/utility.h"
 
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
@@ -40,4 +43,60 @@ TEST_CASE("is_number")
   CHECK(!is_number("'1'"));
 }
 
+TEST_CASE("pairwise_sum")
+{
+  using namespace vita;
+
+  std::vector<double> v;
+  CHECK(pairwise_sum(v.begin(), v.end()) == 0.0);
+
+  for (unsigned i(1); i <= 1000; ++i)
+    v.push_back(i);
+  CHECK(pairwise_sum(v.begin(), v.end()) == 500500.0);
+
+  // Less rounding error than the sequential sum.
+  const std::vector<double> tenths(1000000, 0.1);
+  const auto pairwise(pairwise_sum(tenths.begin(), tenths.end()));
+  const auto sequential(std::accumulate(tenths.begin(), tenths.end(), 0.0));
+  CHECK(std::fabs(pairwise - 100000.0) <= std::fabs(sequential - 100000.0));
+}
+
+TEST_CASE("thread_pool")
+{
+  using namespace vita;
+
+  for (unsigned workers(0); workers <= 3; ++workers)
+  {
+    thread_pool pool(workers);
+    CHECK(pool.workers() == workers);
+
+    for (std::size_t n : {0, 1, 7, 1000})
+    {
+      std::vector<std::atomic<unsigned>> calls(n);
+      pool.parallel_for(n, [&](std::size_t i) { ++calls[i]; });
+
+      CHECK(std::all_of(calls.begin(), calls.end(),
+                        [](const auto &c) { return c == 1; }));
+    }
+
+    // Nested loops don't wait for a free worker.
+    std::atomic<unsigned> nested(0);
+    pool.parallel_for(4, [&](std::size_t)
+    {
+      pool.parallel_for(4, [&](std::size_t) { ++nested; });
+    });
+    CHECK(nested == 16);
+
+    CHECK_THROWS_AS(pool.parallel_for(10, [](std::size_t i)
+                                      {
+                                        if (i == 5)
+                                          throw std::runtime_error("i == 5");
+                                      }),
+                    std::runtime_error);
+  }
+
+  CHECK(thread_pool::shared().workers() + 1
+        >= std::max(std::thread::hardware_concurrency(), 1u));
+}
+
 }  // TEST_SUITE("UTILITY")
@@ -0,0 +1,67 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2024 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#if !defined(VITA_ALIGNED_ALLOCATOR_H)
+#define      VITA_ALIGNED_ALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace vita
+{
+///
+/// A minimal allocator returning memory aligned to `A` bytes.
+///
+/// \tparam T type of the elements
+/// \tparam A alignment (default is the size of a cache line, which is also
+///           enough for every SIMD instruction set in use)
+///
+template<class T, std::size_t A = 64>
+class aligned_allocator
+{
+public:
+  static_assert(A >= alignof(T) && (A & (A - 1)) == 0);
+
+  using value_type = T;
+
+  template<class U> struct rebind { using other = aligned_allocator<U, A>; };
+
+  aligned_allocator() noexcept = default;
+  template<class U>
+  aligned_allocator(const aligned_allocator<U, A> &) noexcept {}
+
+  [[nodiscard]] T *allocate(std::size_t n)
+  {
+    return static_cast<T *>(::operator new(n * sizeof(T),
+                                           std::align_val_t(A)));
+  }
+
+  void deallocate(T *p, std::size_t) noexcept
+  {
+    ::operator delete(p, std::align_val_t(A));
+  }
+
+  template<class U>
+  bool operator==(const aligned_allocator<U, A> &) const noexcept
+  { return true; }
+  template<class U>
+  bool operator!=(const aligned_allocator<U, A> &) const noexcept
+  { return false; }
+};
+
+/// A `std::vector` whose data are aligned to a cache line.
+template<class T> using aligned_vector = std::vector<T, aligned_allocator<T>>;
+
+}  // namespace vita
+
+#endif  // include guard
@@ -0,0 +1,123 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2024 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#if !defined(VITA_MAPPED_FILE_H)
+#define      VITA_MAPPED_FILE_H
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#if !defined(WIN32) && !defined(_WIN32) && !defined(__WIN32)
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#  define VITA_HAS_MMAP
+#endif
+
+namespace vita
+{
+///
+/// A read-only view of the content of a file.
+///
+/// On POSIX systems the file is memory mapped: pages are loaded lazily and
+/// shared among the processes reading the same file. Elsewhere the whole
+/// file is read in memory.
+///
+class mapped_file
+{
+public:
+  explicit mapped_file(const std::filesystem::path &);
+  ~mapped_file();
+
+  mapped_file(const mapped_file &) = delete;
+  mapped_file &operator=(const mapped_file &) = delete;
+
+  /// \return a pointer to the first byte of the file
+  [[nodiscard]] const std::byte *data() const { return data_; }
+
+  /// \return the size of the file in bytes
+  [[nodiscard]] std::size_t size() const { return size_; }
+
+private:
+  const std::byte *data_ = nullptr;
+  std::size_t size_ = 0;
+
+#if !defined(VITA_HAS_MMAP)
+  std::vector<std::byte> buffer_ = {};
+#endif
+};
+
+///
+/// \param[in] fn path of the file to be mapped
+///
+/// \exception std::runtime_error the file cannot be read
+///
+inline mapped_file::mapped_file(const std::filesystem::path &fn)
+{
+#if defined(VITA_HAS_MMAP)
+  const int fd(::open(fn.c_str(), O_RDONLY));
+  if (fd < 0)
+    throw std::runtime_error("Cannot open " + fn.string());
+
+  struct stat st;
+  if (::fstat(fd, &st) < 0)
+  {
+    ::close(fd);
+    throw std::runtime_error("Cannot stat " + fn.string());
+  }
+
+  size_ = static_cast<std::size_t>(st.st_size);
+  if (size_)
+  {
+    void *p(::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0));
+    if (p == MAP_FAILED)
+    {
+      ::close(fd);
+      throw std::runtime_error("Cannot map " + fn.string());
+    }
+
+    ::madvise(p, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const std::byte *>(p);
+  }
+
+  // The mapping keeps its own reference to the file.
+  ::close(fd);
+#else
+  std::ifstream in(fn, std::ios::binary);
+  if (!in)
+    throw std::runtime_error("Cannot open " + fn.string());
+
+  buffer_.resize(static_cast<std::size_t>(std::filesystem::file_size(fn)));
+  if (!in.read(reinterpret_cast<char *>(buffer_.data()),
+               static_cast<std::streamsize>(buffer_.size())))
+    throw std::runtime_error("Cannot read " + fn.string());
+
+  data_ = buffer_.data();
+  size_ = buffer_.size();
+#endif
+}
+
+inline mapped_file::~mapped_file()
+{
+#if defined(VITA_HAS_MMAP)
+  if (data_)
+    ::munmap(const_cast<std::byte *>(data_), size_);
+#endif
+}
+
+}  // namespace vita
+
+#endif  // include guard
@@ -15,11 +15,14 @@
 
 #include <algorithm>
 #include <cassert>
+#include <deque>
 #include <iomanip>
 #include <fstream>
 #include <functional>
 #include <map>
 #include <sstream>
+#include <string_view>
+#include <vector>
 
 namespace pocket_csv
 {
@@ -139,7 +142,6 @@ public:
   }
 
 private:
-  value_type parse_line(const std::string &);
   void get_input();
 
   // Data members MUST BE INITIALIZED IN THE CORRECT ORDER:
@@ -152,6 +154,13 @@ private:
   value_type value_;
 };  // class parser::const_iterator
 
+///
+/// A CSV record whose fields are views of an external buffer.
+///
+/// \see split_line
+///
+using record_view = std::vector<std::string_view>;
+
 namespace detail
 {
 
@@ -187,6 +196,22 @@ struct char_stat
   return {front, back};
 }
 
+///
+/// \param[in] s the input string
+/// \return      a view of `s` without the spaces on both sides
+///
+[[nodiscard]] inline std::string_view trim_view(std::string_view s)
+{
+  const char *spaces(" \f\n\r\t\v");
+
+  const auto front(s.find_first_not_of(spaces));
+  if (front == std::string_view::npos)
+    return {};
+
+  const auto back(s.find_last_not_of(spaces));
+  return s.substr(front, back - front + 1);
+}
+
 ///
 /// \param[in] s the string to be tested
 /// \return      `true` if `s` contains a number
@@ -630,37 +655,14 @@ inline parser::const_iterator parser::end() const
   return const_iterator();
 }
 
-///
-/// Reads into the internal buffer the next record of the CSV file
-///
-inline void parser::const_iterator::get_input()
+namespace detail
 {
-  if (!ptr_)
-  {
-    *this = const_iterator();
-    return;
-  }
-
-  do
-  {
-    std::string line;
-
-    do  // gets the first non-empty line
-      if (!std::getline(*ptr_, line))
-      {
-        *this = const_iterator();
-        return;
-      }
-    while (detail::trim(line).empty());
-
-    value_ = parse_line(line);
-  } while (filter_hook_ && !filter_hook_(value_));
-}
 
 ///
 /// This function parses a line of data by a delimiter.
 ///
 /// \param[in] line line to be parsed
+/// \param[in] d    dialect of the CSV data
 /// \return         a vector where each element is a field of the CSV line
 ///
 /// If you pass in a comma as your delimiter it will parse out a
@@ -670,20 +672,18 @@ inline void parser::const_iterator::get_input()
 /// quotes. This also means the quotes need to be parsed out, this function
 /// accounts for that as well.
 ///
-inline parser::const_iterator::value_type parser::const_iterator::parse_line(
-  const std::string &line)
+inline parser::record_t parse_line(const std::string &line, const dialect &d)
 {
-  value_type record;  // the return value
+  parser::record_t record;  // the return value
 
   const char quote('"');
 
   bool inquotes(false);
   std::string curstring;
 
-  const auto &add_field([&record, this](const std::string &field)
+  const auto &add_field([&record, &d](const std::string &field)
                         {
-                          record.push_back(dialect_.trim_ws
-                                           ? detail::trim(field) : field);
+                          record.push_back(d.trim_ws ? trim(field) : field);
                         });
 
   const auto length(line.length());
@@ -691,10 +691,10 @@ inline parser::const_iterator::value_type parser::const_iterator::parse_line(
   {
     const auto c(line[pos]);
 
-    if (!inquotes && detail::trim(curstring).empty()
+    if (!inquotes && trim(curstring).empty()
         && c == quote)  // begin quote char
     {
-      if (dialect_.quoting == dialect::KEEP_QUOTES)
+      if (d.quoting == dialect::KEEP_QUOTES)
         curstring.push_back(c);
 
       inquotes = true;
@@ -709,13 +709,13 @@ inline parser::const_iterator::value_type parser::const_iterator::parse_line(
       }
       else  // end quote char
       {
-        if (dialect_.quoting == dialect::KEEP_QUOTES)
+        if (d.quoting == dialect::KEEP_QUOTES)
           curstring.push_back(c);
 
         inquotes = false;
       }
     }
-    else if (!inquotes && c == dialect_.delimiter)  // end of field
+    else if (!inquotes && c == d.delimiter)  // end of field
     {
       add_field(curstring);
       curstring = "";
@@ -733,6 +733,143 @@ inline parser::const_iterator::value_type parser::const_iterator::parse_line(
   return record;
 }
 
+}  // namespace detail
+
+///
+/// Reads into the internal buffer the next record of the CSV file
+///
+inline void parser::const_iterator::get_input()
+{
+  if (!ptr_)
+  {
+    *this = const_iterator();
+    return;
+  }
+
+  do
+  {
+    std::string line;
+
+    do  // gets the first non-empty line
+      if (!std::getline(*ptr_, line))
+      {
+        *this = const_iterator();
+        return;
+      }
+    while (detail::trim(line).empty());
+
+    value_ = detail::parse_line(line, dialect_);
+  } while (filter_hook_ && !filter_hook_(value_));
+}
+
+
+///
+/// Extracts the next non-empty line from a buffer of CSV data.
+///
+/// \param[in,out] data CSV data. The extracted line (and the preceding empty
+///                     ones) are removed
+/// \return             the next non-empty line (an empty view when `data` is
+///                     exhausted)
+///
+[[nodiscard]] inline std::string_view next_line(std::string_view &data)
+{
+  while (!data.empty())
+  {
+    const auto eol(data.find('\n'));
+    const auto line(data.substr(0, eol));
+
+    data.remove_prefix(eol == std::string_view::npos ? data.size() : eol + 1);
+
+    if (!detail::trim_view(line).empty())
+      return line;
+  }
+
+  return {};
+}
+
+///
+/// Parses a line of CSV data without copying the fields.
+///
+/// \param[in]  line    line to be parsed
+/// \param[in]  d       dialect of the CSV data
+/// \param[out] fields  the fields of `line`
+/// \param[out] scratch storage for fields which aren't substrings of `line`.
+///                     It must outlive `fields`
+///
+/// Results are the same of the `parser` class. Fields are views of `line`
+/// except for lines containing quotes (uncommon in numeric datasets): they're
+/// parsed by the general algorithm and stored in `scratch`.
+///
+inline void split_line(std::string_view line, const dialect &d,
+                       record_view &fields, std::deque<std::string> &scratch)
+{
+  fields.clear();
+
+  if (line.find('"') != std::string_view::npos)
+  {
+    for (auto &f : detail::parse_line(std::string(line), d))
+    {
+      scratch.push_back(std::move(f));
+      fields.push_back(scratch.back());
+    }
+
+    return;
+  }
+
+  // Parsing stops at the end of the line.
+  line = line.substr(0, line.find_first_of(std::string_view("\0\r\n", 3)));
+
+  for (std::size_t begin(0);;)
+  {
+    const auto end(line.find(d.delimiter, begin));
+    const auto field(line.substr(begin, end - begin));
+
+    fields.push_back(d.trim_ws ? detail::trim_view(field) : field);
+
+    if (end == std::string_view::npos)
+      break;
+    begin = end + 1;
+  }
+}
+
+///
+/// Splits a buffer of CSV data in chunks of complete lines.
+///
+/// \param[in] data CSV data
+/// \param[in] n    required number of chunks
+/// \return         at most `n` consecutive, non-overlapping chunks covering
+///                 `data`
+///
+/// Chunks can be parsed independently (e.g. by different threads).
+///
+/// \warning Multi-line fields aren't supported (see `parser`).
+///
+[[nodiscard]] inline std::vector<std::string_view> split_chunks(
+  std::string_view data, std::size_t n)
+{
+  assert(n);
+
+  std::vector<std::string_view> ret;
+
+  for (std::size_t begin(0), i(1); begin < data.size() && i <= n; ++i)
+  {
+    auto end(std::max(begin, data.size() / n * i));
+
+    if (i == n)
+      end = data.size();
+    else if (const auto eol = data.find('\n', end);
+             eol == std::string_view::npos)
+      end = data.size();
+    else
+      end = eol + 1;
+
+    ret.push_back(data.substr(begin, end - begin));
+    begin = end;
+  }
+
+  return ret;
+}
+
 }  // namespace pocket_csv
 
 #endif  // include guard
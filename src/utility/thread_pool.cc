@@ -0,0 +1,105 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2024 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#include "utility/thread_pool.h"
+
+namespace vita
+{
+
+///
+/// Starts the workers.
+///
+/// \param[in] n number of worker threads
+///
+thread_pool::thread_pool(unsigned n) : stop_(false)
+{
+  workers_.reserve(n);
+  for (unsigned i(0); i < n; ++i)
+    workers_.emplace_back([this] { work(); });
+}
+
+///
+/// Completes the queued tasks and joins the workers.
+///
+thread_pool::~thread_pool()
+{
+  {
+    std::lock_guard lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+
+  for (auto &w : workers_)
+    w.join();
+}
+
+///
+/// \return a pool shared by the whole program
+///
+/// The pool has a worker less than the hardware threads (the calling thread
+/// takes part in `parallel_for`).
+///
+thread_pool &thread_pool::shared()
+{
+  static thread_pool pool(std::max(std::thread::hardware_concurrency(), 1u)
+                          - 1);
+  return pool;
+}
+
+///
+/// \return number of worker threads
+///
+unsigned thread_pool::workers() const
+{
+  return static_cast<unsigned>(workers_.size());
+}
+
+///
+/// Queues a task.
+///
+/// \param[in] task the task to be executed by one of the workers
+///
+void thread_pool::submit(std::function<void ()> task)
+{
+  {
+    std::lock_guard lock(mutex_);
+    tasks_.push_back(std::move(task));
+  }
+
+  cv_.notify_one();
+}
+
+///
+/// Main loop of a worker.
+///
+void thread_pool::work()
+{
+  for (;;)
+  {
+    std::function<void ()> task;
+
+    {
+      std::unique_lock lock(mutex_);
+      cv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+
+      if (tasks_.empty())
+        return;
+
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+
+    task();
+  }
+}
+
+}  // namespace vita
@@ -0,0 +1,128 @@
+/**
+ *  \file
+ *  \remark This file is part of VITA.
+ *
+ *  \copyright Copyright (C) 2024 EOS di Manlio Morini.
+ *
+ *  \license
+ *  This Source Code Form is subject to the terms of the Mozilla Public
+ *  License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ *  You can obtain one at http://mozilla.org/MPL/2.0/
+ */
+
+#if !defined(VITA_THREAD_POOL_H)
+#define      VITA_THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vita
+{
+///
+/// A fixed set of worker threads executing tasks.
+///
+/// The main use is `parallel_for`: the calling thread takes part in the
+/// computation, so a `parallel_for` never waits for a free worker (even when
+/// called by a task of the same pool or when every worker is busy).
+///
+class thread_pool
+{
+public:
+  explicit thread_pool(unsigned);
+  ~thread_pool();
+
+  thread_pool(const thread_pool &) = delete;
+  thread_pool &operator=(const thread_pool &) = delete;
+
+  [[nodiscard]] static thread_pool &shared();
+
+  [[nodiscard]] unsigned workers() const;
+
+  template<class F> void parallel_for(std::size_t, F);
+
+private:
+  void submit(std::function<void ()>);
+  void work();
+
+  std::vector<std::thread> workers_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::function<void ()>> tasks_;
+  bool stop_;
+};
+
+///
+/// Calls a function for every index of a range.
+///
+/// \param[in] n number of indices (`[0, n[`)
+/// \param[in] f function taking an index
+///
+/// Indices are taken, in increasing order, by the calling thread and by the
+/// available workers. The function returns when every call is completed. The
+/// first exception thrown by `f` (if any) is rethrown.
+///
+template<class F>
+void thread_pool::parallel_for(std::size_t n, F f)
+{
+  struct state
+  {
+    std::atomic<std::size_t> next = 0;
+    std::atomic<std::size_t> done = 0;
+
+    std::mutex mutex = {};
+    std::condition_variable cv = {};
+    std::exception_ptr error = nullptr;
+  };
+
+  // Workers may start after the completion of the loop: the shared state
+  // must survive this function (`f` is only used for valid indices).
+  const auto s(std::make_shared<state>());
+
+  const auto loop([s, n, &f]
+  {
+    for (std::size_t i; (i = s->next++) < n;)
+    {
+      try
+      {
+        f(i);
+      }
+      catch (...)
+      {
+        std::lock_guard lock(s->mutex);
+        if (!s->error)
+          s->error = std::current_exception();
+      }
+
+      if (++s->done == n)
+      {
+        std::lock_guard lock(s->mutex);
+        s->cv.notify_all();
+      }
+    }
+  });
+
+  const auto helpers(std::min<std::size_t>(n ? n - 1 : 0, workers_.size()));
+  for (std::size_t i(0); i < helpers; ++i)
+    submit(loop);
+
+  loop();
+
+  std::unique_lock lock(s->mutex);
+  s->cv.wait(lock, [&] { return s->done == n; });
+
+  if (s->error)
+    std::rethrow_exception(s->error);
+}
+
+}  // namespace vita
+
+#endif  // include guard
@@ -16,7 +16,9 @@
 #include <algorithm>
 #include <cmath>
 #include <iomanip>
+#include <iterator>
 #include <fstream>
+#include <numeric>
 #include <sstream>
 
 #include "kernel/common.h"
@@ -207,6 +209,30 @@ bool almost_equal(T v1, T v2, T e = 0.00001)
   return diff <= largest * e;
 }
 
+///
+/// Sums a range of floating point numbers.
+///
+/// \param[in] first beginning of the range
+/// \param[in] last  end of the range
+/// \return          the sum of the elements of `[first, last[`
+///
+/// The range is recursively split in halves (pairwise summation): the rounding
+/// error grows as `O(log n)` instead of `O(n)` and the result only depends on
+/// the sequence of values (not on the way it has been computed).
+///
+template<class It>
+auto pairwise_sum(It first, It last)
+{
+  using T = typename std::iterator_traits<It>::value_type;
+
+  const auto n(std::distance(first, last));
+  if (n <= 8)
+    return std::accumulate(first, last, T(0));
+
+  const auto middle(std::next(first, n / 2));
+  return pairwise_sum(first, middle) + pairwise_sum(middle, last);
+}
+
 ///
 /// \param[out] out the output stream
 /// \param[in]  i   the floating-point value to be saved
@@ -56,6 +56,31 @@ void seed_with_sm64(std::uint64_t seed, T &state)
   std::generate(state.begin(), state.end(), [&sm]{ return sm.next(); });
 }
 
+///
+/// Advances the state of an engine as if `engine()` was called `2^k` times.
+///
+/// \param[in]     poly  the jump polynomial (it identifies `k`)
+/// \param[in,out] state the state of `engine`
+/// \param[in]     e     the engine
+///
+template<class S, class E>
+void jump_with(const S &poly, S &state, E &e) noexcept
+{
+  S s{};
+
+  for (const auto p : poly)
+    for (unsigned b(0); b < 64; ++b)
+    {
+      if (p & (std::uint64_t(1) << b))
+        for (std::size_t i(0); i < s.size(); ++i)
+          s[i] ^= state[i];
+
+      e();
+    }
+
+  state = s;
+}
+
 }  // unnamed namespace
 
 
@@ -79,6 +104,41 @@ void xoshiro256ss::seed(xoshiro256ss::result_type s) noexcept
   seed_with_sm64(s, state);
 }
 
+///
+/// Equivalent to `2^128` calls to `operator()`.
+///
+/// It can be used to generate `2^128` non-overlapping subsequences for
+/// parallel computations.
+///
+void xoshiro256ss::jump() noexcept
+{
+  static constexpr decltype(state) poly =
+  {
+    0x180ec6d33cfd0aba, 0xd5a61266f0c9392c,
+    0xa9582618e03fc9aa, 0x39abdc4529b1661c
+  };
+
+  jump_with(poly, state, *this);
+}
+
+///
+/// Equivalent to `2^192` calls to `operator()`.
+///
+/// It can be used to generate `2^64` starting points, from each of which
+/// `jump()` will generate `2^64` non-overlapping subsequences for parallel
+/// distributed computations.
+///
+void xoshiro256ss::long_jump() noexcept
+{
+  static constexpr decltype(state) poly =
+  {
+    0x76e15d3efefdcbbf, 0xc5004e441c522fb3,
+    0x77710069854ee241, 0x39109bb02acbe635
+  };
+
+  jump_with(poly, state, *this);
+}
+
 ///
 /// Writes to the output stream the representation of the current state.
 ///
@@ -108,7 +168,7 @@ std::ostream &operator<<(std::ostream &o, const xoshiro256ss &e)
 ///
 std::istream &operator>>(std::istream &i, xoshiro256ss &e)
 {
-  return i >> e.state[0] >> e.state[1] >> e.state[2] >> e.state[31];
+  return i >> e.state[0] >> e.state[1] >> e.state[2] >> e.state[3];
 }
 
 ///
@@ -127,6 +187,39 @@ void xoroshiro128p::seed(xoroshiro128p::result_type s) noexcept
   seed_with_sm64(s, state);
 }
 
+///
+/// Equivalent to `2^64` calls to `operator()`.
+///
+/// It can be used to generate `2^64` non-overlapping subsequences for
+/// parallel computations.
+///
+void xoroshiro128p::jump() noexcept
+{
+  static constexpr decltype(state) poly =
+  {
+    0xdf900294d8f554a5, 0x170865df4b3201fc
+  };
+
+  jump_with(poly, state, *this);
+}
+
+///
+/// Equivalent to `2^96` calls to `operator()`.
+///
+/// It can be used to generate `2^32` starting points, from each of which
+/// `jump()` will generate `2^32` non-overlapping subsequences for parallel
+/// distributed computations.
+///
+void xoroshiro128p::long_jump() noexcept
+{
+  static constexpr decltype(state) poly =
+  {
+    0xd2a98b26625eee7b, 0xdddf9b1090aa7ac1
+  };
+
+  jump_with(poly, state, *this);
+}
+
 ///
 /// Writes to the output stream the representation of the current state.
 ///
@@ -111,6 +111,9 @@ public:
   void seed() noexcept ;
   void seed(result_type) noexcept;
 
+  void jump() noexcept;
+  void long_jump() noexcept;
+
   bool operator==(const xoshiro256ss &rhs) const noexcept
   { return state == rhs.state; }
   bool operator!=(const xoshiro256ss &rhs) const noexcept
@@ -180,6 +183,9 @@ public:
   void seed() noexcept ;
   void seed(result_type) noexcept;
 
+  void jump() noexcept;
+  void long_jump() noexcept;
+
   bool operator==(const xoroshiro128p &rhs) const noexcept
   { return state == rhs.state; }
   bool operator!=(const xoroshiro128p &rhs) const noexcept